@@ -0,0 +1,719 @@
+// int2048
+// Lau YeeYu
+
+/**
+ * Benchmarks of every operation of one implementation, chosen by
+ * INT2048_BENCH_BASIC, INT2048_BENCH_BINARY or neither (int2048.hpp, whose
+ * thread scaling is measured as well with SJTU_INT2048_THREADS).
+ * The arguments are the numbers of decimal digits of the operands.
+ *
+ * Example: ./int2048_bench --benchmark_filter=Multiply
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#if defined(INT2048_BENCH_BASIC)
+#include "int2048_basic.hpp"
+using Integer = sjtu::int2048;
+/// The longest operands of the quadratic multiplication and division
+static constexpr long long MaxDigits = 1000000;
+static constexpr long long MaxQuadraticDigits = 10000;
+#elif defined(INT2048_BENCH_BINARY)
+#include "int2048_binary.hpp"
+using Integer = sjtu::int2048_binary;
+/// The decimal conversion is quadratic, which limits every operation
+static constexpr long long MaxDigits = 100000;
+static constexpr long long MaxQuadraticDigits = 100000;
+#else
+#include "fixed_int.hpp"
+#include "int2048.hpp"
+using Integer = sjtu::int2048;
+static constexpr long long MaxDigits = 1000000;
+static constexpr long long MaxQuadraticDigits = 1000000;
+#endif
+
+/// Random decimal digits without a leading zero, the same for every run
+static std::string RandomDigits(long long Length, unsigned Seed)
+{
+    std::mt19937 Generator(Seed + Length);
+    std::uniform_int_distribution<int> Digit(0, 9);
+    std::string Answer(Length, '0');
+    for (char& Char : Answer) Char = '0' + Digit(Generator);
+    Answer[0] = '1' + Digit(Generator) % 9;
+    return Answer;
+}
+
+/// The allocations reaching the global heap, for the allocation counters
+static std::atomic<long long> HeapAllocations{0};
+
+void* operator new(std::size_t Bytes)
+{
+    HeapAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* Pointer = std::malloc(Bytes != 0 ? Bytes : 1)) return Pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t Bytes, std::align_val_t Alignment)
+{
+    HeapAllocations.fetch_add(1, std::memory_order_relaxed);
+    std::size_t Align = static_cast<std::size_t>(Alignment);
+    std::size_t Rounded = (Bytes + Align - 1) / Align * Align;
+    if (void* Pointer = std::aligned_alloc(Align, Rounded != 0 ? Rounded : Align)) {
+        return Pointer;
+    }
+    throw std::bad_alloc();
+}
+
+// The replaced operator new above allocates with malloc, so free is the
+// matching release even though GCC pairs new with delete
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* Pointer) noexcept { std::free(Pointer); }
+void operator delete(void* Pointer, std::size_t) noexcept { std::free(Pointer); }
+void operator delete(void* Pointer, std::align_val_t) noexcept { std::free(Pointer); }
+void operator delete(void* Pointer, std::size_t, std::align_val_t) noexcept
+{
+    std::free(Pointer);
+}
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+/// 1, 10, ..., Max digits
+static void SingleSizes(benchmark::internal::Benchmark* Bench, long long Max)
+{
+    for (long long Length = 1; Length <= Max; Length *= 10) Bench->Arg(Length);
+}
+
+/// Balanced pairs (n, n), and unbalanced pairs (n, n / 100) and (n, 9)
+static void PairSizes(benchmark::internal::Benchmark* Bench, long long Max)
+{
+    for (long long Length = 1; Length <= Max; Length *= 10) {
+        Bench->Args({Length, Length});
+        if (Length >= 10000) Bench->Args({Length, Length / 100});
+        if (Length >= 100) Bench->Args({Length, 9});
+    }
+}
+
+static void LinearSingle(benchmark::internal::Benchmark* Bench)
+{
+    SingleSizes(Bench, MaxDigits);
+}
+
+static void LinearPairs(benchmark::internal::Benchmark* Bench)
+{
+    PairSizes(Bench, MaxDigits);
+}
+
+static void QuadraticPairs(benchmark::internal::Benchmark* Bench)
+{
+    PairSizes(Bench, MaxQuadraticDigits);
+}
+
+static void ConstructFromInteger(benchmark::State& State)
+{
+    long long Value = 1234567890123456789LL;
+    for (auto _ : State) {
+        Integer Answer(Value);
+        benchmark::DoNotOptimize(Answer);
+    }
+}
+BENCHMARK(ConstructFromInteger);
+
+static void ConstructFromString(benchmark::State& State)
+{
+    std::string Digits = RandomDigits(State.range(0), 1);
+    for (auto _ : State) {
+        Integer Answer(Digits);
+        benchmark::DoNotOptimize(Answer);
+    }
+    State.SetBytesProcessed(State.iterations() * Digits.size());
+}
+BENCHMARK(ConstructFromString)->Apply(LinearSingle);
+
+static void Read(benchmark::State& State)
+{
+    std::string Digits = RandomDigits(State.range(0), 1);
+    Integer Answer;
+    for (auto _ : State) {
+        Answer.read(Digits);
+        benchmark::DoNotOptimize(Answer);
+    }
+    State.SetBytesProcessed(State.iterations() * Digits.size());
+}
+BENCHMARK(Read)->Apply(LinearSingle);
+
+static void Print(benchmark::State& State)
+{
+    std::string Digits = RandomDigits(State.range(0), 1);
+    Integer Number(Digits);
+    std::ostringstream Stream;
+    for (auto _ : State) {
+        Stream.str(std::string());
+        Stream << Number;
+        benchmark::DoNotOptimize(Stream);
+    }
+    State.SetBytesProcessed(State.iterations() * Digits.size());
+}
+BENCHMARK(Print)->Apply(LinearSingle);
+
+static void Add(benchmark::State& State)
+{
+    Integer A(RandomDigits(State.range(0), 1));
+    Integer B(RandomDigits(State.range(1), 2));
+    for (auto _ : State) {
+        Integer Answer = A + B;
+        benchmark::DoNotOptimize(Answer);
+    }
+}
+BENCHMARK(Add)->Apply(LinearPairs);
+
+static void Subtract(benchmark::State& State)
+{
+    Integer A(RandomDigits(State.range(0), 1));
+    Integer B(RandomDigits(State.range(1), 2));
+    for (auto _ : State) {
+        Integer Answer = A - B;
+        benchmark::DoNotOptimize(Answer);
+    }
+}
+BENCHMARK(Subtract)->Apply(LinearPairs);
+
+static void Multiply(benchmark::State& State)
+{
+    Integer A(RandomDigits(State.range(0), 1));
+    Integer B(RandomDigits(State.range(1), 2));
+    for (auto _ : State) {
+        Integer Answer = A * B;
+        benchmark::DoNotOptimize(Answer);
+    }
+}
+BENCHMARK(Multiply)->Apply(QuadraticPairs)->Unit(benchmark::kMicrosecond);
+
+/// The dividend has range(0) + range(1) digits, so that the quotient has
+/// about range(0) digits
+static void Divide(benchmark::State& State)
+{
+    Integer A(RandomDigits(State.range(0) + State.range(1), 1));
+    Integer B(RandomDigits(State.range(1), 2));
+    for (auto _ : State) {
+        Integer Answer = A / B;
+        benchmark::DoNotOptimize(Answer);
+    }
+}
+BENCHMARK(Divide)->Apply(QuadraticPairs)->Unit(benchmark::kMicrosecond);
+
+/// The operands only differ in the lowest digit, the worst case
+static void Compare(benchmark::State& State)
+{
+    std::string Digits = RandomDigits(State.range(0), 1);
+    Integer A(Digits);
+    Digits.back() = (Digits.back() == '9') ? '8' : Digits.back() + 1;
+    Integer B(Digits);
+    for (auto _ : State) {
+        benchmark::DoNotOptimize(A < B);
+        benchmark::DoNotOptimize(A == B);
+    }
+}
+BENCHMARK(Compare)->Apply(LinearSingle);
+
+/// Operations with a built-in integer, either passed as it is or converted
+/// to Integer first
+static void IntegerOperand(benchmark::State& State, bool Convert)
+{
+    Integer A(RandomDigits(State.range(0), 1));
+    Integer Counter = A;
+    Integer Answer;
+    for (auto _ : State) {
+        if (Convert) {
+            Counter += Integer(1);
+            Answer = A * Integer(3);
+            Answer = A / Integer(7);
+            benchmark::DoNotOptimize(A < Integer(5));
+        } else {
+            Counter += 1;
+            Answer = A * 3;
+            Answer = A / 7;
+            benchmark::DoNotOptimize(A < 5);
+        }
+        benchmark::DoNotOptimize(Counter);
+        benchmark::DoNotOptimize(Answer);
+    }
+}
+BENCHMARK_CAPTURE(IntegerOperand, converted, true)->Apply(LinearSingle);
+BENCHMARK_CAPTURE(IntegerOperand, native, false)->Apply(LinearSingle);
+
+/// The heap allocations of one operation (w is reused between iterations)
+static void Allocations(benchmark::State& State, int Operation)
+{
+    Integer X(RandomDigits(State.range(0), 1));
+    Integer Y(RandomDigits(State.range(0), 2));
+    Integer Z(RandomDigits(State.range(0) / 2 + 1, 3));
+    Integer W = X;
+    long long Before = HeapAllocations.load(std::memory_order_relaxed);
+    for (auto _ : State) {
+        switch (Operation) {
+            case 0: W = X + Y; break;
+            case 1: W = X - Y; break;
+            case 2: W = X * Y; break;
+            case 3: W = X; W *= Z; break;
+            case 4: W = X / Z; break;
+            case 5: W = X % Z; break;
+            case 6: W = (X + Y) * Z - X; break;
+            case 7: W = X - Y * Z; break;
+        }
+        benchmark::DoNotOptimize(W);
+    }
+    State.counters["allocs"] = benchmark::Counter(
+        HeapAllocations.load(std::memory_order_relaxed) - Before,
+        benchmark::Counter::kAvgIterations);
+}
+BENCHMARK_CAPTURE(Allocations, add, 0)->Arg(39)->Arg(1000);
+BENCHMARK_CAPTURE(Allocations, subtract, 1)->Arg(39)->Arg(1000);
+BENCHMARK_CAPTURE(Allocations, multiply, 2)->Arg(39)->Arg(1000);
+BENCHMARK_CAPTURE(Allocations, assign_multiply, 3)->Arg(39)->Arg(1000);
+BENCHMARK_CAPTURE(Allocations, divide, 4)->Arg(39)->Arg(1000);
+BENCHMARK_CAPTURE(Allocations, remainder, 5)->Arg(39)->Arg(1000);
+BENCHMARK_CAPTURE(Allocations, chain, 6)->Arg(39)->Arg(1000);
+BENCHMARK_CAPTURE(Allocations, submul, 7)->Arg(39)->Arg(1000);
+
+#if !defined(INT2048_BENCH_BASIC) && !defined(INT2048_BENCH_BINARY)
+/// The product of (Low, High] by splitting the range in halves
+static Integer RangeProduct(int Low, int High)
+{
+    if (High - Low == 1) return Integer(High);
+    int Middle = (Low + High) / 2;
+    return RangeProduct(Low, Middle) * RangeProduct(Middle, High);
+}
+
+/// e * 10^Digits by the series 1 / 0! + 1 / 1! + ...
+static Integer SeriesE(int Digits)
+{
+    Integer Term(std::string("1") + std::string(Digits, '0'));
+    Integer Sum = Term;
+    for (long long k = 1; Term != 0; ++k) {
+        Term /= k;
+        Sum += Term;
+    }
+    return Sum;
+}
+
+/// Run Workload(range(0)) with the default memory resource or within the
+/// arena of the thread (reset after every batch)
+template <class Function>
+static void RunBatches(benchmark::State& State, bool UseArena, Function Workload)
+{
+    sjtu::bump_arena& Arena = sjtu::thread_arena();
+    long long Before = HeapAllocations.load(std::memory_order_relaxed);
+    for (auto _ : State) {
+        if (UseArena) {
+            sjtu::memory_resource_scope Scope(&Arena);
+            Integer Answer = Workload(State.range(0));
+            benchmark::DoNotOptimize(Answer);
+        } else {
+            Integer Answer = Workload(State.range(0));
+            benchmark::DoNotOptimize(Answer);
+        }
+        Arena.reset();
+    }
+    State.counters["mallocs"] = benchmark::Counter(
+        HeapAllocations.load(std::memory_order_relaxed) - Before,
+        benchmark::Counter::kAvgIterations);
+}
+
+static void Factorial(benchmark::State& State, bool UseArena)
+{
+    RunBatches(State, UseArena, [](long long n) { return RangeProduct(0, n); });
+}
+BENCHMARK_CAPTURE(Factorial, heap, false)->Arg(1000)->Arg(10000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(Factorial, arena, true)->Arg(1000)->Arg(10000)
+    ->Unit(benchmark::kMicrosecond);
+
+static void Series(benchmark::State& State, bool UseArena)
+{
+    RunBatches(State, UseArena, [](long long Digits) { return SeriesE(Digits); });
+}
+BENCHMARK_CAPTURE(Series, heap, false)->Arg(100)->Arg(1000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(Series, arena, true)->Arg(100)->Arg(1000)
+    ->Unit(benchmark::kMicrosecond);
+
+/// A + B - C + D with a temporary per operator or in one pass with lazy()
+static void LinearCombination(benchmark::State& State, bool Lazy)
+{
+    Integer A(RandomDigits(State.range(0), 1)), B(RandomDigits(State.range(0), 2));
+    Integer C(RandomDigits(State.range(0), 3)), D(RandomDigits(State.range(0), 4));
+    Integer Answer;
+    for (auto _ : State) {
+        if (Lazy) {
+            Answer = sjtu::lazy(A) + B - C + D;
+        } else {
+            Answer = A + B - C + D;
+        }
+        benchmark::DoNotOptimize(Answer);
+    }
+}
+BENCHMARK_CAPTURE(LinearCombination, eager, false)->Apply(LinearSingle);
+BENCHMARK_CAPTURE(LinearCombination, lazy, true)->Apply(LinearSingle);
+
+/// Sum += A * B, the product of range(0) and range(1) digits
+static void AddMul(benchmark::State& State, bool Lazy)
+{
+    Integer A(RandomDigits(State.range(0), 1)), B(RandomDigits(State.range(1), 2));
+    Integer Sum(RandomDigits(State.range(0) + State.range(1), 3));
+    for (auto _ : State) {
+        if (Lazy) {
+            Sum += sjtu::lazy(A) * B;
+        } else {
+            Sum += A * B;
+        }
+        benchmark::DoNotOptimize(Sum);
+    }
+}
+BENCHMARK_CAPTURE(AddMul, eager, false)->Args({100, 9})->Args({100, 100})
+    ->Args({1000, 1000})->Args({100000, 100000})->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(AddMul, lazy, true)->Args({100, 9})->Args({100, 100})
+    ->Args({1000, 1000})->Args({100000, 100000})->Unit(benchmark::kMicrosecond);
+
+static void AddMulFunction(benchmark::State& State)
+{
+    Integer A(RandomDigits(State.range(0), 1)), B(RandomDigits(State.range(1), 2));
+    Integer Sum(RandomDigits(State.range(0) + State.range(1), 3));
+    for (auto _ : State) {
+        sjtu::addmul(Sum, A, B);
+        benchmark::DoNotOptimize(Sum);
+    }
+}
+BENCHMARK(AddMulFunction)->Args({100, 9})->Args({100, 100})->Args({1000, 1000})
+    ->Args({100000, 100000})->Unit(benchmark::kMicrosecond);
+
+/// A * 123456789012345 by an int2048 operand or by mul_ui
+static void MultiplySmall(benchmark::State& State, bool Native)
+{
+    Integer A(RandomDigits(State.range(0), 1));
+    Integer Answer;
+    for (auto _ : State) {
+        Answer = A;
+        if (Native) {
+            sjtu::mul_ui(Answer, 123456789012345ULL);
+        } else {
+            Answer *= Integer(123456789012345LL);
+        }
+        benchmark::DoNotOptimize(Answer);
+    }
+}
+BENCHMARK_CAPTURE(MultiplySmall, int2048, false)->Apply(LinearSingle);
+BENCHMARK_CAPTURE(MultiplySmall, mul_ui, true)->Apply(LinearSingle);
+
+/// A * B with B a copy of A, or square(A)
+static void Square(benchmark::State& State, bool Square)
+{
+    Integer A(RandomDigits(State.range(0), 1));
+    Integer B = A;
+    for (auto _ : State) {
+        Integer Answer = Square ? sjtu::square(A) : A * B;
+        benchmark::DoNotOptimize(Answer);
+    }
+}
+
+static void SquareSizes(benchmark::internal::Benchmark* Bench)
+{
+    for (long long Length : {90, 180, 270, 360, 900, 10000, 100000, 1000000}) {
+        Bench->Arg(Length);
+    }
+    Bench->Unit(benchmark::kMicrosecond);
+}
+BENCHMARK_CAPTURE(Square, multiply, false)->Apply(SquareSizes);
+BENCHMARK_CAPTURE(Square, square, true)->Apply(SquareSizes);
+
+/// 3 ^ range(0)
+static void Power(benchmark::State& State)
+{
+    Integer Base(3);
+    for (auto _ : State) {
+        Integer Answer = sjtu::pow(Base, State.range(0));
+        benchmark::DoNotOptimize(Answer);
+    }
+}
+BENCHMARK(Power)->RangeMultiplier(10)->Range(1000, 1000000)
+    ->Unit(benchmark::kMillisecond);
+
+/// A ^ E modulo M, all of range(0) bits, by square-and-multiply with
+/// operator% (Method 0) or by powmod, which reduces by Barrett reduction for
+/// an even M (Method 1) and by Montgomery reduction for an M coprime to 10
+/// (Method 2)
+static void PowerMod(benchmark::State& State, int Method)
+{
+    long long Digits = State.range(0) * 30103 / 100000;
+    std::string ModDigits = RandomDigits(Digits, 2);
+    ModDigits.back() = Method == 1 ? '8' : '7';
+    Integer A(RandomDigits(Digits, 1));
+    Integer M(ModDigits);
+    std::mt19937 Generator(3);
+    std::string Bits(State.range(0), '0');
+    for (char& Bit : Bits) Bit = '0' + Generator() % 2;
+    Bits[0] = '1';
+    Integer E(0);
+    for (char Bit : Bits) E = E * 2 + (Bit - '0');
+    for (auto _ : State) {
+        Integer Answer(1);
+        if (Method != 0) {
+            Answer = sjtu::powmod(A, E, M);
+        } else {
+            for (char Bit : Bits) {
+                Answer = Answer * Answer % M;
+                if (Bit == '1') Answer = Answer * A % M;
+            }
+        }
+        benchmark::DoNotOptimize(Answer);
+    }
+}
+BENCHMARK_CAPTURE(PowerMod, divide, 0)->Arg(1024)->Arg(4096)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(PowerMod, barrett, 1)->Arg(1024)->Arg(4096)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(PowerMod, montgomery, 2)->Arg(1024)->Arg(4096)
+    ->Unit(benchmark::kMillisecond);
+
+/// A * B modulo an odd M of range(0) bits by operator%, by a
+/// barrett_context and by a montgomery_context (on the Montgomery forms)
+static void ModularMultiply(benchmark::State& State, int Method)
+{
+    long long Digits = State.range(0) * 30103 / 100000;
+    std::string ModDigits = RandomDigits(Digits, 1);
+    ModDigits.back() = '7';
+    Integer M(ModDigits);
+    Integer A = Integer(RandomDigits(Digits, 2)) % M;
+    Integer B = Integer(RandomDigits(Digits, 3)) % M;
+    sjtu::barrett_context Barrett(M);
+    sjtu::montgomery_context Montgomery(M);
+    Integer MA = Montgomery.to_montgomery(A);
+    Integer MB = Montgomery.to_montgomery(B);
+    for (auto _ : State) {
+        Integer Answer;
+        switch (Method) {
+            case 0: Answer = A * B % M; break;
+            case 1: Answer = Barrett.mulmod(A, B); break;
+            default: Answer = Montgomery.mulmod(MA, MB); break;
+        }
+        benchmark::DoNotOptimize(Answer);
+    }
+}
+
+static void ModularSizes(benchmark::internal::Benchmark* Bench)
+{
+    Bench->Arg(256)->Arg(1024)->Arg(4096)->Arg(32768)->Unit(benchmark::kMicrosecond);
+}
+BENCHMARK_CAPTURE(ModularMultiply, divide, 0)->Apply(ModularSizes);
+BENCHMARK_CAPTURE(ModularMultiply, barrett, 1)->Apply(ModularSizes);
+BENCHMARK_CAPTURE(ModularMultiply, montgomery, 2)->Apply(ModularSizes);
+
+/// The range(1)-th root of a number of range(0) digits (sqrtrem for 2)
+static void Root(benchmark::State& State)
+{
+    Integer A(RandomDigits(State.range(0), 1));
+    for (auto _ : State) {
+        if (State.range(1) == 2) {
+            benchmark::DoNotOptimize(sjtu::sqrtrem(A));
+        } else {
+            benchmark::DoNotOptimize(sjtu::iroot(A, State.range(1)));
+        }
+    }
+}
+BENCHMARK(Root)->ArgsProduct({{1000, 10000, 100000, 1000000}, {2, 3, 10}})
+    ->Unit(benchmark::kMillisecond);
+
+/// gcd of two numbers of range(0) digits by gcd or by Euclid's algorithm
+/// with operator%
+static void GCD(benchmark::State& State, bool Euclid)
+{
+    Integer A(RandomDigits(State.range(0), 1));
+    Integer B(RandomDigits(State.range(0), 2));
+    for (auto _ : State) {
+        if (Euclid) {
+            Integer X = A;
+            Integer Y = B;
+            while (Y != 0) {
+                Integer Rest = X % Y;
+                X = std::move(Y);
+                Y = std::move(Rest);
+            }
+            benchmark::DoNotOptimize(X);
+        } else {
+            benchmark::DoNotOptimize(sjtu::gcd(A, B));
+        }
+    }
+}
+BENCHMARK_CAPTURE(GCD, euclid, true)->RangeMultiplier(10)->Range(100, 10000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(GCD, gcd, false)->RangeMultiplier(10)->Range(100, 1000000)
+    ->Unit(benchmark::kMillisecond);
+
+static void ExtendedGCD(benchmark::State& State)
+{
+    Integer A(RandomDigits(State.range(0), 1));
+    Integer B(RandomDigits(State.range(0), 2));
+    Integer X;
+    Integer Y;
+    for (auto _ : State) benchmark::DoNotOptimize(sjtu::xgcd(A, B, X, Y));
+}
+BENCHMARK(ExtendedGCD)->RangeMultiplier(10)->Range(100, 100000)
+    ->Unit(benchmark::kMillisecond);
+
+/// X += B then X -= B in place, and the worst comparison, on range(0)
+/// elements (9 digits each) with the kernels of Level
+static void SimdAddSubtract(benchmark::State& State, sjtu::simd_level Level)
+{
+    sjtu::simd_level Previous = sjtu::get_simd_level();
+    if (sjtu::set_simd_level(Level) != Level) State.SkipWithError("unsupported");
+    Integer X(RandomDigits(9 * State.range(0), 1));
+    Integer B(RandomDigits(9 * State.range(0) - 1, 2));
+    for (auto _ : State) {
+        X += B;
+        X -= B;
+        benchmark::DoNotOptimize(X);
+    }
+    State.SetBytesProcessed(State.iterations() * 2 * 3 * 8 * State.range(0));
+    sjtu::set_simd_level(Previous);
+}
+
+static void SimdCompare(benchmark::State& State, sjtu::simd_level Level)
+{
+    sjtu::simd_level Previous = sjtu::get_simd_level();
+    if (sjtu::set_simd_level(Level) != Level) State.SkipWithError("unsupported");
+    std::string Digits = RandomDigits(9 * State.range(0), 1);
+    Integer A(Digits);
+    Digits.back() = (Digits.back() == '9') ? '8' : Digits.back() + 1;
+    Integer B(Digits);
+    for (auto _ : State) benchmark::DoNotOptimize(A < B);
+    State.SetBytesProcessed(State.iterations() * 2 * 8 * State.range(0));
+    sjtu::set_simd_level(Previous);
+}
+
+static void SimdSizes(benchmark::internal::Benchmark* Bench)
+{
+    Bench->Arg(100000)->Arg(1000000)->Arg(10000000)->Unit(benchmark::kMicrosecond);
+}
+BENCHMARK_CAPTURE(SimdAddSubtract, scalar, sjtu::SimdNone)->Apply(SimdSizes);
+BENCHMARK_CAPTURE(SimdAddSubtract, avx2, sjtu::SimdAVX2)->Apply(SimdSizes);
+BENCHMARK_CAPTURE(SimdAddSubtract, avx512, sjtu::SimdAVX512)->Apply(SimdSizes);
+BENCHMARK_CAPTURE(SimdCompare, scalar, sjtu::SimdNone)->Apply(SimdSizes);
+BENCHMARK_CAPTURE(SimdCompare, avx2, sjtu::SimdAVX2)->Apply(SimdSizes);
+BENCHMARK_CAPTURE(SimdCompare, avx512, sjtu::SimdAVX512)->Apply(SimdSizes);
+
+/// 2000 jobs of every operation: one in 100 has 100000 digits, one in 10
+/// has 1000, and the rest have 20
+static void Batch(benchmark::State& State, bool Scalar)
+{
+    int Count = 2000;
+    std::vector<Integer> Operands;
+    std::vector<sjtu::batch_job> Jobs;
+    for (int i = 0; i < Count; ++i) {
+        long long Length = (i % 100 == 0) ? 100000 : (i % 10 == 0) ? 1000 : 20;
+        Operands.emplace_back(RandomDigits(Length, 2 * i));
+        Operands.emplace_back(RandomDigits(Length / 2 + 1, 2 * i + 1));
+    }
+    for (int i = 0; i < Count; ++i) {
+        Jobs.push_back({sjtu::batch_job::operation(i % 5), &Operands[2 * i],
+                        &Operands[2 * i + 1]});
+    }
+    std::vector<Integer> Answers(Count);
+    for (auto _ : State) {
+        if (!Scalar) {
+            sjtu::batch_eval(Jobs.data(), Count, Answers.data());
+        } else {
+            for (int i = 0; i < Count; ++i) {
+                const Integer& A = *Jobs[i].A;
+                const Integer& B = *Jobs[i].B;
+                switch (Jobs[i].Operation) {
+                    case sjtu::batch_job::Add: Answers[i] = A + B; break;
+                    case sjtu::batch_job::Subtract: Answers[i] = A - B; break;
+                    case sjtu::batch_job::Multiply: Answers[i] = A * B; break;
+                    case sjtu::batch_job::Divide: Answers[i] = A / B; break;
+                    case sjtu::batch_job::Remainder: Answers[i] = A % B; break;
+                }
+            }
+        }
+        benchmark::DoNotOptimize(Answers.data());
+    }
+}
+BENCHMARK_CAPTURE(Batch, scalar, true)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(Batch, batch_eval, false)->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+/// A + B, A * B or A / B for range(0) = 0, 1 or 2
+template <typename Number>
+static void FixedWidthLoop(benchmark::State& State, const Number& A, const Number& B)
+{
+    Number Answer;
+    for (auto _ : State) {
+        switch (State.range(0)) {
+            case 0: Answer = A + B; break;
+            case 1: Answer = A * B; break;
+            default: Answer = A / B; break;
+        }
+        benchmark::DoNotOptimize(Answer);
+    }
+}
+
+/// Operands of about 0.3 and 0.15 * Bits decimal digits in int2048 or in
+/// fixed_int<Bits> (Fixed)
+template <int Bits, bool Fixed>
+static void FixedWidth(benchmark::State& State)
+{
+    Integer A(RandomDigits(Bits * 3 / 10 - 1, 1));
+    Integer B(RandomDigits(Bits * 3 / 20, 2));
+    if constexpr (Fixed) {
+        FixedWidthLoop(State, sjtu::fixed_int<Bits>(A), sjtu::fixed_int<Bits>(B));
+    } else {
+        FixedWidthLoop(State, A, B);
+    }
+}
+BENCHMARK_TEMPLATE2(FixedWidth, 256, false)->DenseRange(0, 2);
+BENCHMARK_TEMPLATE2(FixedWidth, 256, true)->DenseRange(0, 2);
+BENCHMARK_TEMPLATE2(FixedWidth, 2048, false)->DenseRange(0, 2);
+BENCHMARK_TEMPLATE2(FixedWidth, 2048, true)->DenseRange(0, 2);
+
+#ifdef SJTU_INT2048_THREADS
+/// (range(0) digits)^2 on range(1) threads, 1, 2, 4, ... up to all of them
+static void MultiplyThreads(benchmark::State& State)
+{
+    Integer A(RandomDigits(State.range(0), 1));
+    Integer B(RandomDigits(State.range(0), 2));
+    sjtu::parallel::set_threads(State.range(1));
+    for (auto _ : State) {
+        Integer Answer = A * B;
+        benchmark::DoNotOptimize(Answer);
+    }
+    sjtu::parallel::set_threads(std::thread::hardware_concurrency());
+}
+
+static void ThreadCounts(benchmark::internal::Benchmark* Bench)
+{
+    int Hardware = std::max(1, (int)std::thread::hardware_concurrency());
+    for (long long Length : {1000000LL, 10000000LL}) {
+        for (int Threads = 1; Threads < Hardware; Threads *= 2) {
+            Bench->Args({Length, Threads});
+        }
+        Bench->Args({Length, Hardware});
+    }
+}
+BENCHMARK(MultiplyThreads)->Apply(ThreadCounts)->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+#endif
+#endif
+
+BENCHMARK_MAIN();
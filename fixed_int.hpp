@@ -0,0 +1,450 @@
+// int2048
+// Lau YeeYu
+
+#ifndef SJTU_BIGINTEGER_FIXED
+#define SJTU_BIGINTEGER_FIXED
+
+
+/**
+ * FIXED-WIDTH IMPLEMENTATION: "sjtu::fixed_int<Bits>" stores a signed
+ * integer of Bits bits in two's complement in a "std::array" of 64-bit
+ * elements, so it never allocates memory and wraps around modulo 2^Bits as
+ * the built-in integers do. The arithmetic is constexpr, and every loop has
+ * a compile-time bound, so that the compiler can unroll it. Numbers convert
+ * to and from int2048, which also does the decimal reading and printing.
+ */
+
+#include <array>
+#include <iostream>
+#include <string>
+
+#include "int2048.hpp"
+
+#ifndef __SIZEOF_INT128__
+#error "fixed_int needs the unsigned __int128 extension (GCC or Clang)"
+#endif
+
+
+
+namespace sjtu
+{
+    template <int Bits>
+    class fixed_int
+    {
+        static_assert(Bits > 0 && Bits % 64 == 0,
+                      "fixed_int: Bits MUST be a positive multiple of 64");
+
+    public:
+        /// The number of 64-bit elements
+        static constexpr int Elements = Bits / 64;
+
+    private:
+        /// reversed two's complement
+        std::array<unsigned long long, Elements> BigInt{};
+
+        constexpr bool _negative() const;
+
+        /// Two's complement negation, *this = 2^Bits - *this
+        constexpr fixed_int& _negate();
+
+        /// |*this| as an unsigned number (2^(Bits - 1) for the lowest value)
+        constexpr fixed_int _magnitude() const;
+
+        /// The number of elements without the leading zeros (unsigned)
+        constexpr int _length() const;
+
+        /// Unsigned comparison, return -1, 0 or 1
+        static constexpr int _compare(const fixed_int& A, const fixed_int& B);
+
+        /// Unsigned *this = *this * Multiplier + Addend modulo 2^Bits
+        constexpr fixed_int& _multiply_add_small(unsigned long long Multiplier,
+                                                 unsigned long long Addend);
+
+        /// Unsigned *this /= Divisor, return the remainder
+        constexpr unsigned long long _divide_small(unsigned long long Divisor);
+
+        /// Unsigned division (Knuth's Algorithm D),
+        /// Quotient = A / B, Remainder = A % B (CAUTION: B MUST NOT be 0)
+        static constexpr void _divide(fixed_int& Quotient, fixed_int& Remainder,
+                                      const fixed_int& A, const fixed_int& B);
+
+    public:
+        // Constructor
+        constexpr fixed_int() = default;
+        constexpr fixed_int(long long);
+        explicit fixed_int(const std::string&);
+        /// The value modulo 2^Bits
+        explicit fixed_int(const int2048&);
+
+        explicit operator int2048() const;
+
+        /// Load a number (an invalid string is loaded as 0)
+        void read(const std::string&);
+
+        /// Print the number
+        void print() const;
+
+        constexpr fixed_int& add(const fixed_int& B)
+        {
+            return (*this += B);
+        }
+
+        friend constexpr fixed_int add(fixed_int A, const fixed_int& B)
+        {
+            return (A += B);
+        }
+
+        constexpr fixed_int& minus(const fixed_int& B)
+        {
+            return (*this -= B);
+        }
+
+        friend constexpr fixed_int minus(fixed_int A, const fixed_int& B)
+        {
+            return (A -= B);
+        }
+
+        constexpr fixed_int& operator+=(const fixed_int&);
+        constexpr fixed_int& operator-=(const fixed_int&);
+        constexpr fixed_int& operator*=(const fixed_int&);
+        /// Division truncates toward zero and the remainder takes the sign
+        /// of the dividend, as in int2048 (CAUTION: B MUST NOT be 0)
+        constexpr fixed_int& operator/=(const fixed_int&);
+        constexpr fixed_int& operator%=(const fixed_int&);
+
+        friend constexpr fixed_int operator+(fixed_int A, const fixed_int& B)
+        {
+            return (A += B);
+        }
+
+        friend constexpr fixed_int operator-(fixed_int A, const fixed_int& B)
+        {
+            return (A -= B);
+        }
+
+        friend constexpr fixed_int operator*(fixed_int A, const fixed_int& B)
+        {
+            return (A *= B);
+        }
+
+        friend constexpr fixed_int operator/(fixed_int A, const fixed_int& B)
+        {
+            return (A /= B);
+        }
+
+        friend constexpr fixed_int operator%(fixed_int A, const fixed_int& B)
+        {
+            return (A %= B);
+        }
+
+        friend constexpr fixed_int operator-(fixed_int A)
+        {
+            return A._negate();
+        }
+
+        friend std::istream& operator>>(std::istream& Stream, fixed_int& A)
+        {
+            int2048 Value;
+            if (Stream >> Value) A = fixed_int(Value);
+            return Stream;
+        }
+
+        friend std::ostream& operator<<(std::ostream& Stream, const fixed_int& A)
+        {
+            return Stream << int2048(A);
+        }
+
+        friend constexpr bool operator==(const fixed_int& A, const fixed_int& B)
+        {
+            return _compare(A, B) == 0;
+        }
+
+        friend constexpr bool operator!=(const fixed_int& A, const fixed_int& B)
+        {
+            return !(A == B);
+        }
+
+        friend constexpr bool operator<(const fixed_int& A, const fixed_int& B)
+        {
+            // Two's complement keeps the order among numbers of one sign
+            if (A._negative() != B._negative()) return A._negative();
+            return _compare(A, B) == -1;
+        }
+
+        friend constexpr bool operator>(const fixed_int& A, const fixed_int& B)
+        {
+            return B < A;
+        }
+
+        friend constexpr bool operator<=(const fixed_int& A, const fixed_int& B)
+        {
+            return !(B < A);
+        }
+
+        friend constexpr bool operator>=(const fixed_int& A, const fixed_int& B)
+        {
+            return !(A < B);
+        }
+    };
+
+    template <int Bits>
+    constexpr fixed_int<Bits>::fixed_int(long long x)
+    {
+        BigInt[0] = (unsigned long long)x;
+        for (int i = 1; i < Elements; ++i) BigInt[i] = (x < 0) ? ~0ULL : 0;
+    }
+
+    template <int Bits>
+    fixed_int<Bits>::fixed_int(const std::string& String)
+        : fixed_int(int2048(String)) {}
+
+    template <int Bits>
+    fixed_int<Bits>::fixed_int(const int2048& A)
+    {
+        for (int i = A.Size - 1; i >= 0; --i) {
+            _multiply_add_small(Max, (unsigned long long)A.BigInt[i]);
+        }
+        if (!A.IsPositive) _negate();
+    }
+
+    template <int Bits>
+    fixed_int<Bits>::operator int2048() const
+    {
+        // Every element of int2048 takes at least 29 bits
+        std::array<long long, Bits / 29 + 1> Elements10{};
+        fixed_int Magnitude = _magnitude();
+        int Size = 0;
+        do {
+            Elements10[Size++] = (long long)Magnitude._divide_small(Max);
+        } while (Magnitude._length() != 0);
+
+        int2048 Answer;
+        Answer.BigInt.assign(Elements10.data(), Elements10.data() + Size);
+        Answer.Size = Size;
+        Answer.IsPositive = !_negative() || (Size == 1 && Elements10[0] == 0);
+        return Answer;
+    }
+
+    template <int Bits>
+    void fixed_int<Bits>::read(const std::string& String)
+    {
+        *this = fixed_int(int2048(String));
+    }
+
+    template <int Bits>
+    void fixed_int<Bits>::print() const
+    {
+        std::cout << (*this);
+    }
+
+    template <int Bits>
+    constexpr bool fixed_int<Bits>::_negative() const
+    {
+        return (BigInt[Elements - 1] >> 63) != 0;
+    }
+
+    template <int Bits>
+    constexpr fixed_int<Bits>& fixed_int<Bits>::_negate()
+    {
+        unsigned long long Carry = 1;
+        for (int i = 0; i < Elements; ++i) {
+            BigInt[i] = ~BigInt[i] + Carry;
+            Carry = (Carry != 0 && BigInt[i] == 0);
+        }
+        return (*this);
+    }
+
+    template <int Bits>
+    constexpr fixed_int<Bits> fixed_int<Bits>::_magnitude() const
+    {
+        fixed_int Answer = *this;
+        if (_negative()) Answer._negate();
+        return Answer;
+    }
+
+    template <int Bits>
+    constexpr int fixed_int<Bits>::_length() const
+    {
+        int Length = Elements;
+        while (Length > 0 && BigInt[Length - 1] == 0) --Length;
+        return Length;
+    }
+
+    template <int Bits>
+    constexpr int fixed_int<Bits>::_compare(const fixed_int& A, const fixed_int& B)
+    {
+        for (int i = Elements - 1; i >= 0; --i) {
+            if (A.BigInt[i] != B.BigInt[i]) return (A.BigInt[i] > B.BigInt[i]) ? 1 : -1;
+        }
+        return 0;
+    }
+
+    template <int Bits>
+    constexpr fixed_int<Bits>& fixed_int<Bits>::_multiply_add_small(
+        unsigned long long Multiplier, unsigned long long Addend)
+    {
+        unsigned long long Carry = Addend;
+        for (int i = 0; i < Elements; ++i) {
+            unsigned __int128 Temp = (unsigned __int128)BigInt[i] * Multiplier + Carry;
+            BigInt[i] = (unsigned long long)Temp;
+            Carry = (unsigned long long)(Temp >> 64);
+        }
+        return (*this);
+    }
+
+    template <int Bits>
+    constexpr unsigned long long fixed_int<Bits>::_divide_small(unsigned long long Divisor)
+    {
+        unsigned long long Remainder = 0;
+        for (int i = Elements - 1; i >= 0; --i) {
+            unsigned __int128 Temp = ((unsigned __int128)Remainder << 64) | BigInt[i];
+            BigInt[i] = (unsigned long long)(Temp / Divisor);
+            Remainder = (unsigned long long)(Temp % Divisor);
+        }
+        return Remainder;
+    }
+
+    template <int Bits>
+    constexpr void fixed_int<Bits>::_divide(fixed_int& Quotient, fixed_int& Remainder,
+                                            const fixed_int& A, const fixed_int& B)
+    {
+        Quotient = fixed_int();
+        Remainder = fixed_int();
+        int n = B._length();
+        int Length = A._length();
+        if (n == 0) return;
+        if (_compare(A, B) == -1) {
+            Remainder = A;
+            return;
+        }
+        if (n == 1) {
+            Quotient = A;
+            Remainder.BigInt[0] = Quotient._divide_small(B.BigInt[0]);
+            return;
+        }
+
+        // Normalize so that the highest bit of the divisor is set
+        int Shift = __builtin_clzll(B.BigInt[n - 1]);
+        unsigned long long U[Elements + 1] = {};
+        unsigned long long V[Elements] = {};
+        for (int i = n - 1; i >= 0; --i) {
+            V[i] = B.BigInt[i] << Shift;
+            if (Shift != 0 && i > 0) V[i] |= B.BigInt[i - 1] >> (64 - Shift);
+        }
+        for (int i = Length; i >= 0; --i) {
+            unsigned long long High = (i < Length) ? A.BigInt[i] << Shift : 0;
+            if (Shift != 0 && i > 0) High |= A.BigInt[i - 1] >> (64 - Shift);
+            U[i] = High;
+        }
+
+        for (int j = Length - n; j >= 0; --j) {
+            unsigned __int128 Numerator = ((unsigned __int128)U[j + n] << 64)
+                                        | U[j + n - 1];
+            unsigned __int128 Estimate = Numerator / V[n - 1];
+            unsigned __int128 Rest = Numerator % V[n - 1];
+            while ((Estimate >> 64) != 0
+                   || Estimate * V[n - 2] > ((Rest << 64) | U[j + n - 2])) {
+                --Estimate;
+                Rest += V[n - 1];
+                if ((Rest >> 64) != 0) break;
+            }
+
+            // U[j, j + n] -= Estimate * V
+            unsigned long long Carry = 0;
+            unsigned long long Borrow = 0;
+            for (int i = 0; i < n; ++i) {
+                unsigned __int128 Product = Estimate * V[i] + Carry;
+                Carry = (unsigned long long)(Product >> 64);
+                unsigned __int128 Difference = (unsigned __int128)U[i + j]
+                                             - (unsigned long long)Product - Borrow;
+                U[i + j] = (unsigned long long)Difference;
+                Borrow = (unsigned long long)(Difference >> 64) & 1;
+            }
+            unsigned __int128 Top = (unsigned __int128)U[j + n] - Carry - Borrow;
+            U[j + n] = (unsigned long long)Top;
+            if ((Top >> 64) != 0) { // Still one too large, add V back
+                --Estimate;
+                unsigned long long AddCarry = 0;
+                for (int i = 0; i < n; ++i) {
+                    unsigned __int128 Sum = (unsigned __int128)U[i + j] + V[i] + AddCarry;
+                    U[i + j] = (unsigned long long)Sum;
+                    AddCarry = (unsigned long long)(Sum >> 64);
+                }
+                U[j + n] += AddCarry;
+            }
+            Quotient.BigInt[j] = (unsigned long long)Estimate;
+        }
+
+        for (int i = 0; i < n; ++i) {
+            Remainder.BigInt[i] = U[i] >> Shift;
+            if (Shift != 0) Remainder.BigInt[i] |= U[i + 1] << (64 - Shift);
+        }
+    }
+
+    template <int Bits>
+    constexpr fixed_int<Bits>& fixed_int<Bits>::operator+=(const fixed_int& B)
+    {
+        unsigned long long Carry = 0;
+        for (int i = 0; i < Elements; ++i) {
+            unsigned __int128 Sum = (unsigned __int128)BigInt[i] + B.BigInt[i] + Carry;
+            BigInt[i] = (unsigned long long)Sum;
+            Carry = (unsigned long long)(Sum >> 64);
+        }
+        return (*this);
+    }
+
+    template <int Bits>
+    constexpr fixed_int<Bits>& fixed_int<Bits>::operator-=(const fixed_int& B)
+    {
+        unsigned long long Borrow = 0;
+        for (int i = 0; i < Elements; ++i) {
+            unsigned __int128 Difference = (unsigned __int128)BigInt[i] - B.BigInt[i]
+                                         - Borrow;
+            BigInt[i] = (unsigned long long)Difference;
+            Borrow = (unsigned long long)(Difference >> 64) & 1;
+        }
+        return (*this);
+    }
+
+    template <int Bits>
+    constexpr fixed_int<Bits>& fixed_int<Bits>::operator*=(const fixed_int& B)
+    {
+        // Only the products below 2^Bits, the same for both signs
+        std::array<unsigned long long, Elements> Answer{};
+        for (int i = 0; i < Elements; ++i) {
+            unsigned long long Carry = 0;
+            for (int j = 0; i + j < Elements; ++j) {
+                unsigned __int128 Product = (unsigned __int128)BigInt[i] * B.BigInt[j]
+                                          + Answer[i + j] + Carry;
+                Answer[i + j] = (unsigned long long)Product;
+                Carry = (unsigned long long)(Product >> 64);
+            }
+        }
+        BigInt = Answer;
+        return (*this);
+    }
+
+    template <int Bits>
+    constexpr fixed_int<Bits>& fixed_int<Bits>::operator/=(const fixed_int& B)
+    {
+        bool Negative = (_negative() != B._negative());
+        fixed_int Quotient;
+        fixed_int Remainder;
+        _divide(Quotient, Remainder, _magnitude(), B._magnitude());
+        *this = Negative ? Quotient._negate() : Quotient;
+        return (*this);
+    }
+
+    template <int Bits>
+    constexpr fixed_int<Bits>& fixed_int<Bits>::operator%=(const fixed_int& B)
+    {
+        bool Negative = _negative();
+        fixed_int Quotient;
+        fixed_int Remainder;
+        _divide(Quotient, Remainder, _magnitude(), B._magnitude());
+        *this = Negative ? Remainder._negate() : Remainder;
+        return (*this);
+    }
+}
+
+#endif
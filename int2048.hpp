@@ -6,8 +6,8 @@
 
 
 /**
- * COMPRESSED IMPLEMENTATION: By using "std::vector<long long>" to store every
- * 9 digits (decimal-based).
+ * COMPRESSED IMPLEMENTATION: By using "limb_vector" (a vector of long long
+ * keeping small numbers in place) to store every 9 digits (decimal-based).
  */
 
 /**
@@ -27,10 +27,35 @@
 #include <iostream>
 #include <cstring>
 #include <cstdio>
+#include <cmath>
 #include <utility>
 #include <vector>
-#include <complex>
-
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <memory_resource>
+#include <type_traits>
+#ifdef SJTU_INT2048_STATS
+#include <atomic>
+#include <chrono>
+#include <string>
+#endif
+#if !defined(SJTU_INT2048_NO_SIMD) && defined(__x86_64__) \
+    && (defined(__GNUC__) || defined(__clang__))
+// AVX2 and AVX-512 kernels, chosen at run time (see get_simd_level)
+#define SJTU_INT2048_X86_SIMD
+#include <immintrin.h>
+#endif
+#ifdef SJTU_INT2048_THREADS
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#endif
 
 
 namespace sjtu
@@ -40,18 +65,649 @@ namespace sjtu
     static constexpr long long Power[9] = {1, 10, 100, 1000, 10000, 100000,
                                            1000000, 10000000, 100000000};
 
-    /// To reduce the time of allocating memory for vector BigInt
-    /// , but the side effect is larger default size of int2048;
-    static constexpr int Reserve = 32;
+    /// "00", "01", ..., "99" for printing two digits at a time
+    static constexpr char DigitPairs[201] =
+        "0001020304050607080910111213141516171819"
+        "2021222324252627282930313233343536373839"
+        "4041424344454647484950515253545556575859"
+        "6061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+
+    /// The number of elements stored inside int2048 itself, numbers no
+    /// longer than it (below 10^36) never allocate memory
+    static constexpr int InlineElements = 4;
+
+    /// Balanced multiplications below "KaratsubaThreshold" elements use the
+    /// schoolbook loop, those from "Toom3Threshold" elements use Toom-Cook
+    /// 3-way, and Karatsuba is used in between
+    static constexpr int KaratsubaThreshold = 20;
+    static constexpr int Toom3Threshold = 256;
+
+    /// Squares take the schoolbook loop below "SquareKaratsubaThreshold"
+    /// elements, which does half of the products
+    static constexpr int SquareKaratsubaThreshold = 26;
+
+    /// Multiplications whose shorter operand has at least "NTTThreshold"
+    /// elements go through the number-theoretic transform
+    static constexpr int NTTThreshold = 512;
+
+    /// Divisions whose divisor and quotient both have at least
+    /// "NewtonThreshold" elements multiply by the Newton reciprocal instead
+    /// of the long division
+    static constexpr int NewtonThreshold = 256;
+
+    /// GCDs of numbers of at least "HalfGCDThreshold" elements are reduced
+    /// by the half-GCD of their higher parts instead of one element at a time
+    static constexpr int HalfGCDThreshold = 1000;
+
+    /// The half-GCD of fewer than "HalfGCDBaseThreshold" elements takes
+    /// single steps instead of recursing
+    static constexpr int HalfGCDBaseThreshold = 100;
+
+    /// The primes for NTT (all of the form c * 2^k + 1 with primitive root 3)
+    /// , their product (about 7.8e25) bounds the convolution, so every
+    /// element of BigInt can be transformed as a whole
+    static constexpr unsigned NTTMod1 = 998244353;  // 119 * 2^23 + 1
+    static constexpr unsigned NTTMod2 = 167772161;  // 5 * 2^25 + 1
+    static constexpr unsigned NTTMod3 = 469762049;  // 7 * 2^26 + 1
+    static constexpr unsigned NTTRoot = 3;
+    /// The longest transform supported by all the three primes
+    static constexpr int NTTMaxLength = 1 << 23;
+
+    /// Additions, subtractions and comparisons of at least "SimdThreshold"
+    /// elements use the vector kernels of the CPU
+    static constexpr int SimdThreshold = 8;
+
+    /// With SJTU_INT2048_THREADS, transforms of at least "ParallelGrain"
+    /// elements are split into tasks of at least that many elements
+    static constexpr int ParallelGrain = 1 << 14;
+
+#ifdef SJTU_INT2048_STATS
+    /**
+     * Statistics of the hot paths, only compiled with SJTU_INT2048_STATS
+     * defined (otherwise the hooks below expand to nothing).
+     * Every counter is a relaxed atomic, so any thread may update them, and
+     * the time of an operation includes the operations it calls (e.g. the
+     * multiplications in a Newton division).
+     */
+    namespace stats
+    {
+        enum operation
+        {
+            Add, Subtract, Multiply, Divide, Read, Print, OperationCount
+        };
+
+        static constexpr const char* OperationNames[OperationCount] = {
+            "add", "subtract", "multiply", "divide", "read", "print"};
+
+        /// Bucket i counts the operations whose longer operand has
+        /// [2^i, 2^(i + 1)) elements, the last one also counts longer ones
+        static constexpr int Buckets = 16;
+
+        /// A copy of all the counters
+        struct counters
+        {
+            unsigned long long Calls[OperationCount] = {};
+            unsigned long long Nanoseconds[OperationCount] = {};
+            unsigned long long Sizes[OperationCount][Buckets] = {};
+            /// Times that an int2048 moved to a larger buffer
+            unsigned long long Reallocations = 0;
+            /// Times that a division fixed a wrongly estimated digit
+            unsigned long long DivisionCorrections = 0;
+        };
+
+        inline std::atomic<unsigned long long> CallCounter[OperationCount];
+        inline std::atomic<unsigned long long> TimeCounter[OperationCount];
+        inline std::atomic<unsigned long long> SizeCounter[OperationCount][Buckets];
+        inline std::atomic<unsigned long long> ReallocationCounter;
+        inline std::atomic<unsigned long long> DivisionCorrectionCounter;
+
+        /// Every counter is read atomically, but not all of them at once
+        inline counters snapshot()
+        {
+            counters Answer;
+            for (int i = 0; i < OperationCount; ++i) {
+                Answer.Calls[i] = CallCounter[i].load(std::memory_order_relaxed);
+                Answer.Nanoseconds[i] = TimeCounter[i].load(std::memory_order_relaxed);
+                for (int j = 0; j < Buckets; ++j) {
+                    Answer.Sizes[i][j] = SizeCounter[i][j].load(std::memory_order_relaxed);
+                }
+            }
+            Answer.Reallocations = ReallocationCounter.load(std::memory_order_relaxed);
+            Answer.DivisionCorrections
+                = DivisionCorrectionCounter.load(std::memory_order_relaxed);
+            return Answer;
+        }
+
+        inline void reset()
+        {
+            for (int i = 0; i < OperationCount; ++i) {
+                CallCounter[i].store(0, std::memory_order_relaxed);
+                TimeCounter[i].store(0, std::memory_order_relaxed);
+                for (int j = 0; j < Buckets; ++j) {
+                    SizeCounter[i][j].store(0, std::memory_order_relaxed);
+                }
+            }
+            ReallocationCounter.store(0, std::memory_order_relaxed);
+            DivisionCorrectionCounter.store(0, std::memory_order_relaxed);
+        }
+
+        /// {"add": {"calls": ..., "nanoseconds": ..., "sizes": [...]}, ...,
+        ///  "reallocations": ..., "division_corrections": ...}
+        inline std::string to_json(const counters& Counters)
+        {
+            std::string Answer = "{";
+            for (int i = 0; i < OperationCount; ++i) {
+                Answer += "\"" + std::string(OperationNames[i]) + "\": {\"calls\": "
+                          + std::to_string(Counters.Calls[i]) + ", \"nanoseconds\": "
+                          + std::to_string(Counters.Nanoseconds[i]) + ", \"sizes\": [";
+                for (int j = 0; j < Buckets; ++j) {
+                    if (j != 0) Answer += ", ";
+                    Answer += std::to_string(Counters.Sizes[i][j]);
+                }
+                Answer += "]}, ";
+            }
+            Answer += "\"reallocations\": " + std::to_string(Counters.Reallocations)
+                      + ", \"division_corrections\": "
+                      + std::to_string(Counters.DivisionCorrections) + "}";
+            return Answer;
+        }
+
+        /// Count one operation on Size elements and its time until the end
+        /// of the scope
+        class scope
+        {
+        private:
+            operation Operation;
+            std::chrono::steady_clock::time_point Start;
+
+        public:
+            scope(operation Operation, long long Size)
+                : Operation(Operation), Start(std::chrono::steady_clock::now())
+            {
+                int Bucket = 0;
+                while (Bucket + 1 < Buckets && (Size >> (Bucket + 1)) != 0) ++Bucket;
+                CallCounter[Operation].fetch_add(1, std::memory_order_relaxed);
+                SizeCounter[Operation][Bucket].fetch_add(1, std::memory_order_relaxed);
+            }
+
+            ~scope()
+            {
+                auto Time = std::chrono::steady_clock::now() - Start;
+                TimeCounter[Operation].fetch_add(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(Time).count(),
+                    std::memory_order_relaxed);
+            }
+
+            scope(const scope&) = delete;
+            scope& operator=(const scope&) = delete;
+        };
+    }
+
+/// Count an operation (a member of stats::operation) until the end of scope
+#define SJTU_INT2048_RECORD(Operation, Size) \
+    ::sjtu::stats::scope StatsScope(::sjtu::stats::Operation, (Size))
+/// Add one to a counter of namespace stats
+#define SJTU_INT2048_COUNT(Counter) \
+    ::sjtu::stats::Counter.fetch_add(1, std::memory_order_relaxed)
+#else
+#define SJTU_INT2048_RECORD(Operation, Size) ((void)0)
+#define SJTU_INT2048_COUNT(Counter) ((void)0)
+#endif
+
+#ifdef SJTU_INT2048_THREADS
+    /**
+     * The parallel multiplication, only compiled with SJTU_INT2048_THREADS
+     * defined (otherwise everything runs on the calling thread).
+     * The number-theoretic transforms of large multiplications are split
+     * into tasks of a work-stealing pool. Every task computes exactly what
+     * the serial loop does, so the results never depend on the threads.
+     */
+    namespace parallel
+    {
+        /// A fixed set of threads, each with its own deque of tasks. A thread
+        /// runs its newest task first and steals the oldest tasks of the
+        /// others. A thread waiting for a task group runs tasks meanwhile,
+        /// so tasks may create and wait for tasks themselves.
+        /// Jobs (whole operations of batch_eval) are kept apart from the
+        /// other tasks (pieces of a multiplication): a thread waiting for
+        /// pieces only runs pieces, so no job starts on a thread in the middle
+        /// of another one, which uses the numbers of the thread
+        class thread_pool
+        {
+        private:
+            struct queue
+            {
+                std::mutex Mutex;
+                std::deque<std::function<void()>> Tasks;
+                std::deque<std::function<void()>> Jobs;
+            };
+
+            /// Queue 0 takes the tasks of the threads outside the pool
+            std::vector<std::unique_ptr<queue>> Queues;
+            std::vector<std::thread> Workers;
+            std::atomic<int> Pending{0};
+            std::mutex SleepMutex;
+            std::condition_variable Sleep;
+            bool Stop = false;
+
+            inline static thread_local const thread_pool* CurrentPool = nullptr;
+            inline static thread_local int CurrentQueue = 0;
+
+            int _queue() const
+            {
+                return (CurrentPool == this) ? CurrentQueue : 0;
+            }
+
+            void _work(int Queue)
+            {
+                CurrentPool = this;
+                CurrentQueue = Queue;
+                while (true) {
+                    if (run_one()) continue;
+                    std::unique_lock<std::mutex> Lock(SleepMutex);
+                    Sleep.wait(Lock, [this] { return Stop || Pending.load() > 0; });
+                    if (Stop) return;
+                }
+            }
+
+        public:
+            /// Threads - 1 workers are started, since the thread waiting for
+            /// the tasks runs them as well
+            explicit thread_pool(int Threads)
+            {
+                Threads = std::max(Threads, 1);
+                for (int i = 0; i < Threads; ++i) {
+                    Queues.push_back(std::make_unique<queue>());
+                }
+                for (int i = 1; i < Threads; ++i) {
+                    Workers.emplace_back([this, i] { _work(i); });
+                }
+            }
+
+            ~thread_pool()
+            {
+                {
+                    std::lock_guard<std::mutex> Lock(SleepMutex);
+                    Stop = true;
+                }
+                Sleep.notify_all();
+                for (std::thread& Worker : Workers) Worker.join();
+            }
+
+            thread_pool(const thread_pool&) = delete;
+            thread_pool& operator=(const thread_pool&) = delete;
+
+            int size() const
+            {
+                return (int)Queues.size();
+            }
+
+            void submit(std::function<void()> Task, bool Job = false)
+            {
+                queue& Queue = *Queues[_queue()];
+                {
+                    std::lock_guard<std::mutex> Lock(Queue.Mutex);
+                    (Job ? Queue.Jobs : Queue.Tasks).push_back(std::move(Task));
+                }
+                Pending.fetch_add(1);
+                // A worker between its check of Pending and its wait holds
+                // the mutex, so the notification cannot be lost
+                { std::lock_guard<std::mutex> Lock(SleepMutex); }
+                Sleep.notify_one();
+            }
+
+            /// Run one task if there is any, a piece before a job and a job
+            /// only if Jobs, return whether one was run
+            bool run_one(bool Jobs = true)
+            {
+                if (Pending.load() == 0) return false;
+                int Own = _queue();
+                std::function<void()> Task;
+                for (int Kind = 0; Kind < (Jobs ? 2 : 1) && !Task; ++Kind) {
+                    for (int i = 0; i < size() && !Task; ++i) {
+                        queue& Queue = *Queues[(Own + i) % size()];
+                        std::lock_guard<std::mutex> Lock(Queue.Mutex);
+                        auto& Tasks = (Kind == 0) ? Queue.Tasks : Queue.Jobs;
+                        if (Tasks.empty()) continue;
+                        if (i == 0) {
+                            Task = std::move(Tasks.back());
+                            Tasks.pop_back();
+                        } else {
+                            Task = std::move(Tasks.front());
+                            Tasks.pop_front();
+                        }
+                    }
+                }
+                if (!Task) return false;
+                Pending.fetch_sub(1);
+                Task();
+                return true;
+            }
+        };
+
+        /// Tasks run on a pool and waited for together, the first exception
+        /// thrown by a task is rethrown by wait(). The tasks of a group of
+        /// jobs are jobs of the pool, and only its wait() runs other jobs
+        class task_group
+        {
+        private:
+            thread_pool& Pool;
+            bool Jobs;
+            std::atomic<int> Remaining{0};
+            std::mutex ErrorMutex;
+            std::exception_ptr Error;
+
+            void _join()
+            {
+                while (Remaining.load() > 0) {
+                    if (!Pool.run_one(Jobs)) std::this_thread::yield();
+                }
+            }
+
+        public:
+            explicit task_group(thread_pool& Pool, bool Jobs = false)
+                : Pool(Pool), Jobs(Jobs) {}
+
+            ~task_group()
+            {
+                _join();
+            }
+
+            task_group(const task_group&) = delete;
+            task_group& operator=(const task_group&) = delete;
+
+            template <class Function>
+            void run(Function Task)
+            {
+                Remaining.fetch_add(1);
+                Pool.submit([this, Task = std::move(Task)]() mutable {
+                    try {
+                        Task();
+                    } catch (...) {
+                        std::lock_guard<std::mutex> Lock(ErrorMutex);
+                        if (!Error) Error = std::current_exception();
+                    }
+                    Remaining.fetch_sub(1);
+                }, Jobs);
+            }
+
+            void wait()
+            {
+                _join();
+                if (Error) std::rethrow_exception(std::exchange(Error, nullptr));
+            }
+        };
+
+        inline std::mutex PoolMutex;
+        inline std::unique_ptr<thread_pool> SharedPool;
+        inline int ThreadCount = std::max(1, (int)std::thread::hardware_concurrency());
+
+        /// Use Threads threads (the calling one included) for the
+        /// multiplications from now on, 1 turns the parallel mode off
+        /// (CAUTION: MUST NOT be called while a multiplication is running)
+        inline void set_threads(int Threads)
+        {
+            std::lock_guard<std::mutex> Lock(PoolMutex);
+            ThreadCount = std::max(Threads, 1);
+            SharedPool.reset();
+        }
+
+        /// The number of threads, all the hardware threads by default
+        inline int threads()
+        {
+            std::lock_guard<std::mutex> Lock(PoolMutex);
+            return ThreadCount;
+        }
+
+        /// The pool of the multiplications, nullptr for a single thread
+        inline thread_pool* pool()
+        {
+            std::lock_guard<std::mutex> Lock(PoolMutex);
+            if (ThreadCount == 1) return nullptr;
+            if (!SharedPool) SharedPool = std::make_unique<thread_pool>(ThreadCount);
+            return SharedPool.get();
+        }
+    }
+#endif
+
+    /// Run Body(First, Last) over pieces of [Begin, End) of at least Grain
+    /// elements, on the threads of parallel::pool() if there are several
+    template <class Function>
+    void _parallel_for(long long Begin, long long End, long long Grain,
+                       Function Body)
+    {
+#ifdef SJTU_INT2048_THREADS
+        parallel::thread_pool* Pool
+            = (End - Begin >= 2 * Grain) ? parallel::pool() : nullptr;
+        if (Pool != nullptr) {
+            long long Pieces = std::min((End - Begin) / Grain, 4LL * Pool->size());
+            parallel::task_group Group(*Pool);
+            for (long long i = 1; i < Pieces; ++i) {
+                Group.run([=] {
+                    Body(Begin + (End - Begin) * i / Pieces,
+                         Begin + (End - Begin) * (i + 1) / Pieces);
+                });
+            }
+            Body(Begin, Begin + (End - Begin) / Pieces);
+            Group.wait();
+            return;
+        }
+#endif
+        (void)Grain;
+        Body(Begin, End);
+    }
+
+    /// Call every task, at the same time if Parallel and there are several
+    /// threads
+    template <class... Functions>
+    void _parallel_invoke(bool Parallel, Functions&&... Tasks)
+    {
+#ifdef SJTU_INT2048_THREADS
+        parallel::thread_pool* Pool = Parallel ? parallel::pool() : nullptr;
+        if (Pool != nullptr) {
+            parallel::task_group Group(*Pool);
+            (Group.run(std::ref(Tasks)), ...);
+            Group.wait();
+            return;
+        }
+#endif
+        (void)Parallel;
+        (Tasks(), ...);
+    }
 
     bool AbsCompareLess(const std::vector<long long>& A, int Start, int End,
                         const std::vector<long long>& B, int BLength);
 
+    /// The instructions of the add, subtract and compare kernels
+    enum simd_level
+    {
+        SimdNone, SimdAVX2, SimdAVX512
+    };
+
+    /// The level in use, the best one of the CPU by default
+    simd_level get_simd_level();
+
+    /// Use at most Level (e.g. to compare the kernels) for all the threads,
+    /// return the level in use, which the CPU supports
+    /// (CAUTION: MUST NOT be called while another thread computes)
+    simd_level set_simd_level(simd_level Level);
+
+    /// The memory resource that the numbers created on this thread allocate
+    /// from (nullptr for the global operator new, the default)
+    std::pmr::memory_resource* get_memory_resource();
+
+    /// Let the numbers created later on this thread allocate from Resource
+    /// (nullptr for the global operator new), return the previous resource
+    std::pmr::memory_resource* set_memory_resource(std::pmr::memory_resource* Resource);
+
+    /// Use Resource on this thread until the end of the scope
+    class memory_resource_scope
+    {
+    private:
+        std::pmr::memory_resource* Previous;
+
+    public:
+        explicit memory_resource_scope(std::pmr::memory_resource* Resource);
+        ~memory_resource_scope();
+
+        memory_resource_scope(const memory_resource_scope&) = delete;
+        memory_resource_scope& operator=(const memory_resource_scope&) = delete;
+    };
+
+    /**
+     * @brief A bump allocator for batches of short-lived numbers.
+     *
+     * Allocation only moves a pointer and deallocation does nothing, reset()
+     * forgets everything at once but keeps the memory (merged into one
+     * block) for the next batch.
+     * CAUTION: every number allocated from the arena MUST be destroyed (or
+     * copied out of a memory_resource_scope of it) before reset().
+     */
+    class bump_arena : public std::pmr::memory_resource
+    {
+    private:
+        /// The header of every block taken from the upstream resource
+        struct block
+        {
+            block* Next;
+            std::size_t Bytes;
+        };
+
+        std::pmr::memory_resource* Upstream;
+        block* Blocks = nullptr; /// The newest block first
+        char* Current = nullptr;
+        char* End = nullptr;
+        std::size_t TotalBytes = 0;
+
+        void _add_block(std::size_t Bytes);
+        void _release();
+
+        void* do_allocate(std::size_t Bytes, std::size_t Alignment) override;
+        void do_deallocate(void*, std::size_t, std::size_t) override;
+        bool do_is_equal(const std::pmr::memory_resource& Other) const noexcept override;
+
+    public:
+        explicit bump_arena(std::size_t InitialBytes = 1 << 16,
+                            std::pmr::memory_resource* Upstream
+                                = std::pmr::get_default_resource());
+        ~bump_arena() override;
+
+        bump_arena(const bump_arena&) = delete;
+        bump_arena& operator=(const bump_arena&) = delete;
+
+        /// Forget every allocation and keep the memory for reuse
+        void reset();
+
+        /// The bytes taken from the upstream resource
+        std::size_t capacity() const;
+    };
+
+    /// The bump arena of this thread
+    bump_arena& thread_arena();
+
+    /**
+     * @brief The storage of int2048, a vector of long long which keeps up to
+     * "InlineElements" elements in place and only moves to the heap when it
+     * grows longer (iterators are plain pointers).
+     *
+     * Like std::pmr::vector, the memory resource is chosen at construction
+     * (the one of the thread, or the one of the source for the move
+     * constructor) and never changes, assignment between different
+     * resources copies the elements. So only the move constructor is
+     * noexcept: a move assignment or a swap across resources allocates.
+     */
+    class limb_vector
+    {
+    private:
+        long long* Data;
+        int Length = 0;
+        int Capacity = InlineElements;
+        std::pmr::memory_resource* Resource; /// nullptr for operator new
+        long long Inline[InlineElements];
+
+        bool _is_inline() const;
+
+        /// Take a buffer of Count elements from the resource
+        long long* _allocate(int Count);
+
+        /// Give the heap buffer back to the resource
+        void _release();
+
+    public:
+        limb_vector();
+        explicit limb_vector(std::pmr::memory_resource* Resource);
+        limb_vector(int Count, long long Value);
+        limb_vector(const limb_vector&);
+        limb_vector(limb_vector&&) noexcept;
+        ~limb_vector();
+
+        limb_vector& operator=(const limb_vector&);
+        limb_vector& operator=(limb_vector&&);
+
+        std::pmr::memory_resource* resource() const;
+        std::size_t size() const;
+        std::size_t capacity() const;
+        long long* data();
+        const long long* data() const;
+        long long* begin();
+        const long long* begin() const;
+        long long* end();
+        const long long* end() const;
+        long long& operator[](int Index);
+        const long long& operator[](int Index) const;
+
+        /// Make room for at least Count elements, keeping the content
+        void reserve(int Count);
+        void resize(int Count, long long Value = 0);
+        void assign(int Count, long long Value);
+        void assign(const long long* First, const long long* Last);
+        void clear();
+        void push_back(long long Value);
+        long long* insert(long long* Position, int Count, long long Value);
+        long long* erase(long long* First, long long* Last);
+        void swap(limb_vector&);
+    };
+
+    template <int Terms, int Products>
+    class lazy_sum;
+
+    template <int Bits>
+    class fixed_int;
+
+    class int2048;
+
+    /// One independent operation of batch_eval(), *A op *B
+    struct batch_job
+    {
+        enum operation
+        {
+            Add, Subtract, Multiply, Divide, Remainder
+        };
+
+        operation Operation;
+        const int2048* A;
+        const int2048* B;
+    };
+
+    /// Result when Type is a built-in integer (but not bool), so that the
+    /// overloads for built-in integers are exact matches for every such type
+    template <class Type, class Result>
+    using enable_if_integer = std::enable_if_t<
+        std::is_integral_v<Type> && !std::is_same_v<Type, bool>, Result>;
+
+    /// |A| of a built-in integer (the lowest value of a signed type included)
+    template <class Integer>
+    unsigned long long _integer_magnitude(Integer A);
+
+    template <class Integer>
+    bool _integer_positive(Integer A);
+
     class int2048
     {
     private:
         /// reversed big int
-        std::vector<long long> BigInt = std::vector<long long>(Reserve, 0);
+        limb_vector BigInt = limb_vector(1, 0);
         bool IsPositive = true;
         int Size = 1; /// The number of elements used in the vector
 
@@ -69,8 +725,273 @@ namespace sjtu
         /// Resize the "BigInt" (For clear zero in the beginning of the int)
         int2048& _resize();
 
-        std::vector<long long>& _single_multiply(std::vector<long long>&,
-                                                 long long A) const;
+        /// *this = *this * A in one pass over the elements
+        int2048& _single_multiply(unsigned long long A);
+
+        /// Write the elements of A to Answer[0, 3), return how many are used
+        static int _split_limbs(long long* Answer, unsigned long long A);
+
+        /// The kernels of the operators with built-in integers, B is given
+        /// by its absolute value and sign
+        int2048& _add_small(unsigned long long BMagnitude, bool BPositive);
+        int2048& _multiply_small(unsigned long long BMagnitude, bool BPositive);
+        int2048& _divide_small(unsigned long long BMagnitude, bool BPositive,
+                               bool Remainder);
+        /// Return the sign of *this - B
+        int _compare_small(unsigned long long BMagnitude, bool BPositive) const;
+
+        /// Whether Chars[0, 8) are all decimal digits
+        static bool _is_eight_digits(const char* Chars);
+
+        /// Parse the 8 decimal digits Chars[0, 8)
+        static long long _parse_eight_digits(const char* Chars);
+
+        /// Write all the 9 digits of Element (0 <= Element < Max) to Buffer
+        static void _print_element(char* Buffer, long long Element);
+
+        /// Multiply |*this| by Max^Count (or divide it when Count < 0)
+        int2048& _shift(int Count);
+
+        /// Unsigned division, Quotient = |A| / |B|, Remainder = |A| % |B|
+        static void _divide(int2048& Quotient, int2048& Remainder,
+                            const int2048& A, const int2048& B);
+
+        /// Long division estimating every element by the highest two
+        /// elements of the remainder (Knuth's Algorithm D)
+        static void _basecase_divide(int2048& Quotient, int2048& Remainder,
+                                     const int2048& A, const int2048& B);
+
+        /// Division by the Newton reciprocal of B
+        static void _newton_divide(int2048& Quotient, int2048& Remainder,
+                                   const int2048& A, const int2048& B);
+
+        /// Return floor(Max^(2 * B.Size) / |B|) by Newton iteration
+        static int2048 _reciprocal(const int2048& B);
+
+        /// Root = floor(A^(1 / K)) and Power = Root^K (CAUTION: A > 0, K >= 2)
+        static void _root(int2048& Root, int2048& Power, const int2048& A,
+                          unsigned long long K);
+
+        /// One Newton step for the K-th root of A from X = Root * Max^Shift,
+        /// Root = ((K - 1) * X + A / X^(K - 1)) / K, which is no less than
+        /// floor(A^(1 / K)) afterwards (CAUTION: Root > 0)
+        static void _root_step(int2048& Root, const int2048& A,
+                               unsigned long long K, int Shift);
+
+        /// The GCD loop, A = gcd(A, B) and B = 0, and Matrix = M * Matrix when
+        /// given, where M maps (A, B) to (gcd, 0) (CAUTION: A >= B >= 0)
+        static void _gcd(int2048& A, int2048& B, int2048 (*Matrix)[2]);
+
+        /// Half-GCD of numbers of n = max(A.Size, B.Size) elements: subtract
+        /// multiples of one from the other as long as both keep more than
+        /// n / 2 + 1 elements, and set M such that the old (A, B) is
+        /// M * (A, B). M has non-negative elements and determinant 1, and
+        /// reduces any numbers sharing the higher n elements of (A, B) just
+        /// as well. Return false if there was no step (CAUTION: A, B >= 0
+        /// and M MUST be the identity)
+        static bool _hgcd(int2048& A, int2048& B, int2048 (*M)[2]);
+
+        /// Reduce (A, B) by the half-GCD of A / Max^Low and B / Max^Low,
+        /// (A, B) = M^-1 * (A, B), return false if there was no step
+        /// (CAUTION: A, B >= 0 and M MUST be the identity)
+        static bool _hgcd_reduce(int2048& A, int2048& B, int Low,
+                                 int2048 (*M)[2]);
+
+        /// One step of _hgcd, where both numbers keep more than Stop
+        /// elements: the cofactors of the highest 18 digits by machine
+        /// integers, or one division, M = M * Step. Return false if the
+        /// difference of A and B has at most Stop elements
+        static bool _hgcd_step(int2048& A, int2048& B, int Stop,
+                               int2048 (*M)[2]);
+
+        /// M = M * Step
+        static void _multiply_matrix(int2048 (*M)[2], const int2048 (*Step)[2]);
+
+        /// Some Euclidean steps at once by Lehmer's algorithm on the highest
+        /// two elements, return false if there was none (A >= B >= 0)
+        static bool _lehmer_step(int2048& A, int2048& B, int2048 (*Matrix)[2]);
+
+        /// One Euclidean step, (A, B) = (B, A mod B) (CAUTION: B > 0)
+        static void _division_step(int2048& A, int2048& B, int2048 (*Matrix)[2]);
+
+        /// (X, Y) = Step * (X, Y)
+        static void _apply_matrix(const int2048 (*Step)[2], int2048& X, int2048& Y);
+
+        /// Keep the lowest Count elements, *this %= Max^Count (*this >= 0)
+        int2048& _truncate(int Count);
+
+        /// Barrett reduction, X = X mod Mod with Reciprocal = _reciprocal(Mod)
+        /// (CAUTION: 0 <= X < Max^(2 * Mod.Size) and Mod > 0)
+        static void _barrett_reduce(int2048& X, const int2048& Mod,
+                                    const int2048& Reciprocal);
+
+        /// Answer = Base ^ (the exponent of Bits bits, bit i is Bit(i)) by
+        /// left-to-right sliding windows over the odd powers of Base, every
+        /// product is passed to Reduce
+        template <class BitFunction, class ReduceFunction>
+        static void _sliding_window_power(int2048& Answer, const int2048& Base,
+                                          long long Bits, BitFunction Bit,
+                                          ReduceFunction Reduce);
+
+        /// Signed multiplication, Answer = A * B
+        /// (CAUTION: Answer MUST NOT be A or B)
+        static void _signed_multiply(int2048& Answer, const int2048& A,
+                                     const int2048& B);
+
+        /// Answer = the result of Job, written into the memory of Answer
+        /// (CAUTION: Answer MUST NOT be an operand of Job)
+        static void _batch_evaluate(const batch_job& Job, int2048& Answer);
+
+        /// The estimated time of Job, in elementary operations on elements
+        static long long _batch_cost(const batch_job& Job);
+
+        /// *this += B[0, BSize) (or -= when !BPositive)
+        int2048& _add_signed_limbs(const long long* B, int BSize, bool BPositive);
+
+        /// *this += A * B (or -= when Negative), the schoolbook products are
+        /// accumulated in place when the signs agree
+        int2048& _addmul(const int2048& A, const int2048& B, bool Negative);
+
+        /// *this += |A| * |B| (or -= when !Positive), A and B MAY be in *this
+        int2048& _addmul(const long long* A, int ASize,
+                         const long long* B, int BSize, bool Positive);
+
+        /// Answer = the sum of *Values[i] (negated when Negative[i]) in one
+        /// pass over the elements (Values MAY include Answer)
+        static void _linear_combination(int2048& Answer,
+                                        const int2048* const* Values,
+                                        const bool* Negative, int Count);
+
+        /// Unsigned multiplication, Answer = |A| * |B|
+        /// (Answer will be resized to ASize + BSize elements)
+        static void _multiply(limb_vector& Answer,
+                              const long long* A, int ASize,
+                              const long long* B, int BSize);
+
+        /// Recursive multiplication dispatching among schoolbook, Karatsuba
+        /// and Toom-3, Answer[0, ASize + BSize) = |A| * |B|
+        /// (Scratch MUST hold _multiply_scratch_size(max(ASize, BSize)))
+        static void _multiply_recursive(long long* Answer,
+                                        const long long* A, int ASize,
+                                        const long long* B, int BSize,
+                                        long long* Scratch);
+
+        /// Karatsuba multiplication (CAUTION: (ASize + 1) / 2 < BSize <= ASize)
+        static void _karatsuba_multiply(long long* Answer,
+                                        const long long* A, int ASize,
+                                        const long long* B, int BSize,
+                                        long long* Scratch);
+
+        /// Toom-Cook 3-way multiplication, evaluating at 0, 1, 2, 3 and
+        /// infinity so that every intermediate value stays non-negative
+        /// (CAUTION: 2 * ((ASize + 2) / 3) < BSize <= ASize)
+        static void _toom3_multiply(long long* Answer,
+                                    const long long* A, int ASize,
+                                    const long long* B, int BSize,
+                                    long long* Scratch);
+
+        /// The number of elements of scratch needed by _multiply_recursive
+        static int _multiply_scratch_size(int Size);
+
+        /// Answer = A + B (CAUTION: ASize >= BSize), return the carry
+        static long long _add_limbs(long long* Answer,
+                                    const long long* A, int ASize,
+                                    const long long* B, int BSize);
+
+        /// Answer = A - B (CAUTION: A >= B and ASize >= BSize), return the borrow
+        static long long _sub_limbs(long long* Answer,
+                                    const long long* A, int ASize,
+                                    const long long* B, int BSize);
+
+        /// Answer[0, Size) = A + B, return the carry, by the kernel of
+        /// get_simd_level() (Answer MAY be A or B in all of the kernels)
+        static long long _add_n(long long* Answer, const long long* A,
+                                const long long* B, int Size);
+        static long long _add_n_scalar(long long* Answer, const long long* A,
+                                       const long long* B, int Size);
+
+        /// Answer[0, Size) = A - B, return the borrow
+        static long long _sub_n(long long* Answer, const long long* A,
+                                const long long* B, int Size);
+        static long long _sub_n_scalar(long long* Answer, const long long* A,
+                                       const long long* B, int Size);
+
+        /// Return the sign of A[0, Size) - B[0, Size)
+        static int _compare_n(const long long* A, const long long* B, int Size);
+        static int _compare_n_scalar(const long long* A, const long long* B,
+                                     int Size);
+
+#ifdef SJTU_INT2048_X86_SIMD
+        /// The carry into every element of a block comes from comparing the
+        /// sums with Max - 1 and resolving the carries of the whole block as
+        /// one integer addition on the lane masks
+        static long long _add_n_avx2(long long* Answer, const long long* A,
+                                     const long long* B, int Size);
+        static long long _sub_n_avx2(long long* Answer, const long long* A,
+                                     const long long* B, int Size);
+        static int _compare_n_avx2(const long long* A, const long long* B,
+                                   int Size);
+        static long long _add_n_avx512(long long* Answer, const long long* A,
+                                       const long long* B, int Size);
+        static long long _sub_n_avx512(long long* Answer, const long long* A,
+                                       const long long* B, int Size);
+        static int _compare_n_avx512(const long long* A, const long long* B,
+                                     int Size);
+#endif
+
+        /// Answer = A * Multiplier (CAUTION: Multiplier < Max), return the carry
+        static long long _mul_limbs_small(long long* Answer,
+                                          const long long* A, int ASize,
+                                          long long Multiplier);
+
+        /// Return A % Divisor
+        static long long _mod_limbs_small(const long long* A, int ASize,
+                                          long long Divisor);
+
+        /// A = A / Divisor, return the remainder
+        static long long _div_limbs_small(long long* A, int ASize,
+                                          long long Divisor);
+
+        /// Answer[0, AnswerSize) += A, the carry is propagated to the end
+        static void _accumulate(long long* Answer, int AnswerSize,
+                                const long long* A, int ASize);
+
+        /// Answer[0, AnswerSize) += A * B, the carry is propagated to the end
+        /// (CAUTION: AnswerSize > ASize + BSize)
+        static void _addmul_limbs(long long* Answer, int AnswerSize,
+                                  const long long* A, int ASize,
+                                  const long long* B, int BSize);
+
+        /// Schoolbook multiplication (CAUTION: Answer MUST be filled with 0)
+        static void _schoolbook_multiply(long long* Answer,
+                                         const long long* A, int ASize,
+                                         const long long* B, int BSize);
+
+        /// Schoolbook squaring, the products A[i] * A[j] with i < j are
+        /// summed once and doubled (CAUTION: Answer MUST be filled with 0)
+        static void _schoolbook_square(long long* Answer,
+                                       const long long* A, int Size);
+
+        /// Three-prime NTT multiplication, combined by CRT
+        /// (CAUTION: Answer MUST be filled with 0)
+        static void _ntt_multiply(long long* Answer,
+                                  const long long* A, int ASize,
+                                  const long long* B, int BSize);
+
+        /// Cyclic convolution of A and B modulo "Mod" with "Length" points
+        template <unsigned Mod>
+        static std::vector<unsigned> _ntt_convolve(const long long* A, int ASize,
+                                                   const long long* B, int BSize,
+                                                   int Length);
+
+        /// In-place NTT (or inverse NTT) modulo "Mod"
+        template <unsigned Mod>
+        static void _ntt(std::vector<unsigned>& Data, bool Inverse);
+
+        /// Return Base ^ Exponent modulo "Mod"
+        template <unsigned Mod>
+        static unsigned _power_mod(unsigned long long Base,
+                                   unsigned long long Exponent);
 
     public:
         // Constructor
@@ -81,7 +1002,7 @@ namespace sjtu
         int2048(int2048&&) noexcept;
 
 
-        /// Load a Big Int
+        /// Load a Big Int (an invalid string is loaded as 0)
         void read(const std::string&);
 
         /// Print the Big Int
@@ -98,22 +1019,202 @@ namespace sjtu
         friend int2048 minus(int2048 A, const int2048& B);
 
         int2048& operator=(const int2048&);
+        /// Copies (and may throw) when the memories come from different resources
+        int2048& operator=(int2048&&);
 
+        /// The binary operators have overloads for temporaries, which reuse
+        /// the memory of the temporary for the result instead of copying
         int2048& operator+=(const int2048&);
-        friend int2048 operator+(int2048, const int2048&);
+        friend int2048 operator+(const int2048&, const int2048&);
+        friend int2048 operator+(int2048&&, const int2048&);
+        friend int2048 operator+(const int2048&, int2048&&);
+        friend int2048 operator+(int2048&&, int2048&&);
 
         int2048& operator-=(const int2048&);
-        friend int2048 operator-(int2048, const int2048&);
+        friend int2048 operator-(const int2048&, const int2048&);
+        friend int2048 operator-(int2048&&, const int2048&);
+        friend int2048 operator-(const int2048&, int2048&&);
+        friend int2048 operator-(int2048&&, int2048&&);
+
+        int2048& operator*=(const int2048&);
+        friend int2048 operator*(const int2048&, const int2048&);
+        friend int2048 operator*(int2048&&, const int2048&);
+        friend int2048 operator*(const int2048&, int2048&&);
+        friend int2048 operator*(int2048&&, int2048&&);
+
+        /// Squaring, *this *= *this (sqr) or A * A (square). A product of a
+        /// number with itself (A * A, A *= A) is squared as well, computing
+        /// every cross product once and transforming the operand once
+        int2048& sqr();
+        friend int2048 square(const int2048& A);
+
+        /// Base ^ Exponent by left-to-right sliding windows (0 ^ 0 is 1)
+        friend int2048 pow(const int2048& Base, unsigned long long Exponent);
+
+        /// Base ^ Exponent modulo |Mod|, in [0, |Mod|), every step reduces by
+        /// Montgomery reduction (Mod coprime to 10) or by the precomputed
+        /// reciprocal of Mod instead of a division
+        /// (CAUTION: Exponent MUST be non-negative and Mod MUST NOT be 0)
+        friend int2048 powmod(const int2048& Base, const int2048& Exponent,
+                              const int2048& Mod);
+
+        /// Integer roots by Newton steps from the root of the higher half,
+        /// which double the precision, so that the total cost is a few
+        /// multiplications of the full size. isqrt(A) = floor(sqrt(A)),
+        /// sqrtrem(A) is {isqrt(A), A - isqrt(A)^2}, and iroot(A, K) is the
+        /// K-th root truncated toward zero
+        /// (CAUTION: K >= 1, and A MUST be non-negative for even K)
+        friend int2048 isqrt(const int2048& A);
+        friend std::pair<int2048, int2048> sqrtrem(const int2048& A);
+        friend int2048 iroot(const int2048& A, unsigned long long K);
+
+        /// The greatest common divisor (non-negative, gcd(0, 0) = 0) by
+        /// Lehmer's algorithm on the highest two elements, and by half-GCD
+        /// for long numbers
+        friend int2048 gcd(const int2048& A, const int2048& B);
 
-        int2048& operator*=(int2048);
-        friend int2048 operator*(int2048, const int2048&);
+        /// The least common multiple (non-negative, 0 if A or B is 0)
+        friend int2048 lcm(const int2048& A, const int2048& B);
 
-        int2048& operator/=(int2048);
-        friend int2048 operator/(int2048, const int2048&);
+        /// Return gcd(A, B) and set X and Y such that A * X + B * Y = gcd(A, B)
+        friend int2048 xgcd(const int2048& A, const int2048& B,
+                            int2048& X, int2048& Y);
 
+        /// The inverse of A modulo |Mod| in [0, |Mod|), or 0 if there is none
+        /// (CAUTION: Mod MUST NOT be 0)
+        friend int2048 invmod(const int2048& A, const int2048& Mod);
+
+        /// Division truncates toward zero and the remainder takes the sign
+        /// of the dividend (as built-in integers do), so that
+        /// A == A / B * B + A % B
+        int2048& operator/=(const int2048&);
+        friend int2048 operator/(const int2048&, const int2048&);
+        friend int2048 operator/(int2048&&, const int2048&);
+
+        int2048& operator%=(const int2048&);
+        friend int2048 operator%(const int2048&, const int2048&);
+        friend int2048 operator%(int2048&&, const int2048&);
+
+        /// Return the quotient and the remainder of one division
+        friend std::pair<int2048, int2048> divmod(const int2048&, const int2048&);
+
+        /**
+         * Answers[i] = the result of Jobs[i] for every i < Count. With
+         * SJTU_INT2048_THREADS the jobs are spread over the threads of the
+         * pool, the longest first, while the short ones are grouped, and
+         * every answer reuses its own memory.
+         * (CAUTION: no operand may be one of the answers)
+         */
+        friend void batch_eval(const batch_job* Jobs, int Count, int2048* Answers);
+#ifdef SJTU_INT2048_THREADS
+        friend void batch_eval(const batch_job* Jobs, int Count, int2048* Answers,
+                               parallel::thread_pool& Pool);
+#endif
+
+        /// The operators with built-in integers run in one pass over the
+        /// elements without converting the integer to int2048
+        template <class Integer>
+        enable_if_integer<Integer, int2048&> operator+=(Integer);
+        template <class Integer>
+        enable_if_integer<Integer, int2048&> operator-=(Integer);
+        template <class Integer>
+        enable_if_integer<Integer, int2048&> operator*=(Integer);
+        template <class Integer>
+        enable_if_integer<Integer, int2048&> operator/=(Integer);
+        template <class Integer>
+        enable_if_integer<Integer, int2048&> operator%=(Integer);
+
+        template <class Integer>
+        friend enable_if_integer<Integer, int2048> operator+(const int2048&, Integer);
+        template <class Integer>
+        friend enable_if_integer<Integer, int2048> operator+(int2048&&, Integer);
+        template <class Integer>
+        friend enable_if_integer<Integer, int2048> operator+(Integer, const int2048&);
+        template <class Integer>
+        friend enable_if_integer<Integer, int2048> operator+(Integer, int2048&&);
+
+        template <class Integer>
+        friend enable_if_integer<Integer, int2048> operator-(const int2048&, Integer);
+        template <class Integer>
+        friend enable_if_integer<Integer, int2048> operator-(int2048&&, Integer);
+        template <class Integer>
+        friend enable_if_integer<Integer, int2048> operator-(Integer, const int2048&);
+        template <class Integer>
+        friend enable_if_integer<Integer, int2048> operator-(Integer, int2048&&);
+
+        template <class Integer>
+        friend enable_if_integer<Integer, int2048> operator*(const int2048&, Integer);
+        template <class Integer>
+        friend enable_if_integer<Integer, int2048> operator*(int2048&&, Integer);
+        template <class Integer>
+        friend enable_if_integer<Integer, int2048> operator*(Integer, const int2048&);
+        template <class Integer>
+        friend enable_if_integer<Integer, int2048> operator*(Integer, int2048&&);
+
+        template <class Integer>
+        friend enable_if_integer<Integer, int2048> operator/(const int2048&, Integer);
+        template <class Integer>
+        friend enable_if_integer<Integer, int2048> operator/(int2048&&, Integer);
+        template <class Integer>
+        friend enable_if_integer<Integer, int2048> operator%(const int2048&, Integer);
+        template <class Integer>
+        friend enable_if_integer<Integer, int2048> operator%(int2048&&, Integer);
+
+        template <class Integer>
+        friend enable_if_integer<Integer, bool> operator==(const int2048&, Integer);
+        template <class Integer>
+        friend enable_if_integer<Integer, bool> operator!=(const int2048&, Integer);
+        template <class Integer>
+        friend enable_if_integer<Integer, bool> operator<(const int2048&, Integer);
+        template <class Integer>
+        friend enable_if_integer<Integer, bool> operator>(const int2048&, Integer);
+        template <class Integer>
+        friend enable_if_integer<Integer, bool> operator<=(const int2048&, Integer);
+        template <class Integer>
+        friend enable_if_integer<Integer, bool> operator>=(const int2048&, Integer);
+        template <class Integer>
+        friend enable_if_integer<Integer, bool> operator==(Integer, const int2048&);
+        template <class Integer>
+        friend enable_if_integer<Integer, bool> operator!=(Integer, const int2048&);
+        template <class Integer>
+        friend enable_if_integer<Integer, bool> operator<(Integer, const int2048&);
+        template <class Integer>
+        friend enable_if_integer<Integer, bool> operator>(Integer, const int2048&);
+        template <class Integer>
+        friend enable_if_integer<Integer, bool> operator<=(Integer, const int2048&);
+        template <class Integer>
+        friend enable_if_integer<Integer, bool> operator>=(Integer, const int2048&);
+
+        /// Accumulate a product in place, Answer += A * B (addmul) or
+        /// Answer -= A * B (submul), without a temporary for the product
+        /// when the operands are small and the signs agree
+        friend int2048& addmul(int2048& Answer, const int2048& A, const int2048& B);
+        friend int2048& submul(int2048& Answer, const int2048& A, const int2048& B);
+        friend int2048& addmul_ui(int2048& Answer, const int2048& A,
+                                  unsigned long long B);
+        friend int2048& submul_ui(int2048& Answer, const int2048& A,
+                                  unsigned long long B);
+
+        /// Answer *= B in place, in one pass over the elements
+        friend int2048& mul_ui(int2048& Answer, unsigned long long B);
+
+        /// Read a whitespace-separated word, failbit is set (and the object
+        /// is left unchanged) unless the whole word is a number
         friend std::istream& operator>>(std::istream &, int2048&);
         friend std::ostream& operator<<(std::ostream &, const int2048&);
 
+        /// Write the decimal form into [First, Last) without a terminating
+        /// '\0' (the same contract as std::to_chars), at most
+        /// 9 * Size + 1 characters are needed
+        friend std::to_chars_result to_chars(char* First, char* Last,
+                                             const int2048&);
+
+        /// Parse an optional '-' and decimal digits from [First, Last) (the
+        /// same contract as std::from_chars), return invalid_argument and
+        /// leave the object unchanged if there is no digit
+        friend std::from_chars_result from_chars(const char* First,
+                                                 const char* Last, int2048&);
+
         friend int AbsCompare(const int2048&, const int2048&);
 
         inline friend bool operator==(const int2048&, const int2048&);
@@ -122,683 +1223,3544 @@ namespace sjtu
         inline friend bool operator>(const int2048&, const int2048&);
         inline friend bool operator<=(const int2048&, const int2048&);
         inline friend bool operator>=(const int2048&, const int2048&);
+
+        template <int Terms, int Products>
+        friend class lazy_sum;
+
+        template <int Bits>
+        friend class fixed_int;
+
+        friend class montgomery_context;
+        friend class barrett_context;
     };
 
-    int2048::int2048()
+    /**
+     * @brief A lazy sum of int2048 terms and products started by lazy(), as in
+     * "int2048 x = lazy(a) + b - c + d" or "acc += lazy(x) * y".
+     *
+     * The plain terms are added in one pass over the elements with a single
+     * carry sweep (together with the left side of += and -=), then every
+     * product is accumulated into the result without a product temporary.
+     * It only refers to its operands, so it MUST be used within the
+     * statement that builds it (never stored in an "auto" variable).
+     */
+    template <int Terms, int Products>
+    class lazy_sum
     {
-        BigInt.push_back(0);
-    }
+    public:
+        const int2048* Values[Terms > 0 ? Terms : 1];
+        bool Negative[Terms > 0 ? Terms : 1];
+        const int2048* Factors[Products > 0 ? Products : 1][2];
+        bool ProductNegative[Products > 0 ? Products : 1];
 
-    int2048::int2048(long long x)
-    {
-        if (x == 0) {
-            BigInt.push_back(0);
-        } else {
-            if (x < 0) {
-                IsPositive = false;
-                x = -x;
-            }
-            int i = 0;
-            while (x != 0) {
-                BigInt.resize(3, 0);
-                BigInt[i] = x % Max;
-                x = x / Max;
-                ++i;
-            }
-            Size = i;
-        }
-    }
+        operator int2048() const;
 
-    int2048::int2048(const std::string& String)
-    {
-        if (String[0] == '-') {
-            if (String[1] == '0') {
-                BigInt.push_back(0);
-            } else {
-                IsPositive = false;
-                Size = (String.length() - 2) / MaxDigit + 1;
-                BigInt.resize(Size, 0);
-                int i = String.length() - 1;
-                int Count = 0;
-                 while ( i >= MaxDigit) {
-                     for (int j = 0; j < MaxDigit; ++j) {
-                         BigInt[Count] += (String[i - j] - 48) * Power[j];
-                     }
-                     i -= MaxDigit;
-                     ++Count;
-                 }
-                 for (int j = 0; i > 0; ++j) {
-                     BigInt[Count] += (String[i] - 48) * Power[j];
-                     --i;
-                 }
-            }
-        } else {
-            Size = (String.length() - 1) / MaxDigit + 1;
-            BigInt.resize(Size, 0);
-            int i = String.length() - 1;
-            int Count = 0;
-            while ( i >= MaxDigit - 1) {
-                for (int j = 0; j < MaxDigit; ++j) {
-                    BigInt[Count] += (String[i - j] - 48) * Power[j];
-                }
-                i -= MaxDigit;
-                ++Count;
-            }
-            for (int j = 0; i >= 0; ++j) {
-                BigInt[Count] += (String[i] - 48) * Power[j];
-                --i;
-            }
-        }
-    }
+        /// Answer = (Accumulate ? Answer : 0) + (Negate ? -1 : 1) * (*this)
+        void evaluate(int2048& Answer, bool Accumulate, bool Negate) const;
+    };
 
-    int2048::int2048(const int2048&) = default;
+    /// Start a lazy expression (see lazy_sum)
+    lazy_sum<1, 0> lazy(const int2048& A);
 
-    int2048::int2048(int2048&&) noexcept = default;
+    /// Whether Type is int2048 (of any reference), so that the lazy operators
+    /// are exact matches for temporaries as well
+    template <class Type>
+    using enable_if_int2048
+        = std::enable_if_t<std::is_same_v<std::decay_t<Type>, int2048>, int>;
 
-    void int2048::read(const std::string& String)
-    {
-        BigInt.clear();
-        if (String[0] == '-') {
-            if (String[1] == '0') {
-                BigInt.push_back(0);
-                IsPositive = true;
-                Size = 1;
+    template <int T1, int P1, int T2, int P2>
+    lazy_sum<T1 + T2, P1 + P2> operator+(const lazy_sum<T1, P1>&,
+                                         const lazy_sum<T2, P2>&);
+    template <int T1, int P1, int T2, int P2>
+    lazy_sum<T1 + T2, P1 + P2> operator-(const lazy_sum<T1, P1>&,
+                                         const lazy_sum<T2, P2>&);
+    template <int T, int P>
+    lazy_sum<T, P> operator-(const lazy_sum<T, P>&);
+
+    template <int T, int P, class Value, enable_if_int2048<Value> = 0>
+    lazy_sum<T + 1, P> operator+(const lazy_sum<T, P>&, Value&&);
+    template <int T, int P, class Value, enable_if_int2048<Value> = 0>
+    lazy_sum<T + 1, P> operator+(Value&&, const lazy_sum<T, P>&);
+    template <int T, int P, class Value, enable_if_int2048<Value> = 0>
+    lazy_sum<T + 1, P> operator-(const lazy_sum<T, P>&, Value&&);
+    template <int T, int P, class Value, enable_if_int2048<Value> = 0>
+    lazy_sum<T + 1, P> operator-(Value&&, const lazy_sum<T, P>&);
+
+    /// A product is made of two single terms, e.g. lazy(x) * y
+    lazy_sum<0, 1> operator*(const lazy_sum<1, 0>&, const lazy_sum<1, 0>&);
+    template <class Value, enable_if_int2048<Value> = 0>
+    lazy_sum<0, 1> operator*(const lazy_sum<1, 0>&, Value&&);
+    template <class Value, enable_if_int2048<Value> = 0>
+    lazy_sum<0, 1> operator*(Value&&, const lazy_sum<1, 0>&);
+
+    template <int T, int P>
+    int2048& operator+=(int2048&, const lazy_sum<T, P>&);
+    template <int T, int P>
+    int2048& operator-=(int2048&, const lazy_sum<T, P>&);
+
+    /**
+     * @brief Montgomery arithmetic modulo a fixed Mod with R = Max^n (n is
+     * the number of elements of Mod), for many multiplications by the same
+     * modulus.
+     *
+     * A residue A is kept as A * R mod Mod (to_montgomery), and the product
+     * of two of them is reduced by redc(T) = T / R mod Mod, which adds a
+     * multiple of Mod to clear the lowest n elements, so it costs about two
+     * multiplications and no division. Mod MUST be coprime to 10 (the base
+     * is 10^9).
+     */
+    class montgomery_context
+    {
+    public:
+        explicit montgomery_context(const int2048& Mod);
+
+        const int2048& modulus() const;
+
+        /// A * R mod Mod in [0, Mod) for any A
+        int2048 to_montgomery(const int2048& A) const;
+
+        /// A / R mod Mod, the value of the Montgomery form A
+        int2048 from_montgomery(const int2048& A) const;
+
+        /// T / R mod Mod in [0, Mod) (CAUTION: 0 <= T < Mod * R)
+        int2048 redc(const int2048& T) const;
+
+        /// The Montgomery form of the product (square) of Montgomery forms
+        /// (CAUTION: A and B MUST be in [0, Mod))
+        int2048 mulmod(const int2048& A, const int2048& B) const;
+        int2048 sqrmod(const int2048& A) const;
+
+    private:
+        int2048 Mod;
+
+        /// -1 / Mod modulo Max for the element-wise reduction of short moduli
+        long long Inverse;
+
+        /// -1 / Mod modulo R for the reduction by multiplications
+        int2048 InverseR;
+
+        /// R^2 mod Mod
+        int2048 RSquared;
+
+        /// T = T / R mod Mod in place
+        void _redc(int2048& T) const;
+
+        friend int2048 powmod(const int2048& Base, const int2048& Exponent,
+                              const int2048& Mod);
+    };
+
+    /**
+     * @brief Barrett arithmetic modulo a fixed |Mod|, which keeps the
+     * reciprocal floor(Max^(2n) / |Mod|), so that reducing a number below
+     * Max^(2n) (a product of two residues) costs two multiplications and at
+     * most two subtractions instead of a division.
+     */
+    class barrett_context
+    {
+    public:
+        /// (CAUTION: Mod MUST NOT be 0)
+        explicit barrett_context(const int2048& Mod);
+
+        const int2048& modulus() const;
+
+        /// A mod |Mod| in [0, |Mod|) for any A (a division when A is at
+        /// least Max^(2n))
+        int2048 reduce(const int2048& A) const;
+
+        /// A * B (A * A) mod |Mod| (CAUTION: A and B MUST be in [0, |Mod|))
+        int2048 mulmod(const int2048& A, const int2048& B) const;
+        int2048 sqrmod(const int2048& A) const;
+
+    private:
+        int2048 Mod;
+        int2048 Reciprocal;
+    };
+
+    std::pmr::memory_resource*& _thread_memory_resource()
+    {
+        static thread_local std::pmr::memory_resource* Resource = nullptr;
+        return Resource;
+    }
+
+    std::pmr::memory_resource* get_memory_resource()
+    {
+        return _thread_memory_resource();
+    }
+
+    std::pmr::memory_resource* set_memory_resource(std::pmr::memory_resource* Resource)
+    {
+        std::pmr::memory_resource* Previous = _thread_memory_resource();
+        _thread_memory_resource() = Resource;
+        return Previous;
+    }
+
+    memory_resource_scope::memory_resource_scope(std::pmr::memory_resource* Resource)
+        : Previous(set_memory_resource(Resource)) {}
+
+    memory_resource_scope::~memory_resource_scope()
+    {
+        set_memory_resource(Previous);
+    }
+
+    bump_arena::bump_arena(std::size_t InitialBytes,
+                           std::pmr::memory_resource* Upstream)
+        : Upstream(Upstream)
+    {
+        _add_block(InitialBytes);
+    }
+
+    bump_arena::~bump_arena()
+    {
+        _release();
+    }
+
+    void bump_arena::_add_block(std::size_t Bytes)
+    {
+        Bytes += sizeof(block);
+        block* Block = static_cast<block*>(Upstream->allocate(Bytes, alignof(block)));
+        Block->Next = Blocks;
+        Block->Bytes = Bytes;
+        Blocks = Block;
+        Current = reinterpret_cast<char*>(Block + 1);
+        End = reinterpret_cast<char*>(Block) + Bytes;
+        TotalBytes += Bytes;
+    }
+
+    void bump_arena::_release()
+    {
+        while (Blocks != nullptr) {
+            block* Next = Blocks->Next;
+            Upstream->deallocate(Blocks, Blocks->Bytes, alignof(block));
+            Blocks = Next;
+        }
+        TotalBytes = 0;
+    }
+
+    void* bump_arena::do_allocate(std::size_t Bytes, std::size_t Alignment)
+    {
+        std::size_t Padding = (Alignment - reinterpret_cast<std::uintptr_t>(Current)
+                               % Alignment) % Alignment;
+        if (Current == nullptr || Padding + Bytes > std::size_t(End - Current)) {
+            // Every block is at least as large as all the previous ones
+            _add_block(std::max(Bytes + Alignment, TotalBytes));
+            Padding = (Alignment - reinterpret_cast<std::uintptr_t>(Current)
+                       % Alignment) % Alignment;
+        }
+        void* Answer = Current + Padding;
+        Current += Padding + Bytes;
+        return Answer;
+    }
+
+    void bump_arena::do_deallocate(void*, std::size_t, std::size_t) {}
+
+    bool bump_arena::do_is_equal(const std::pmr::memory_resource& Other) const noexcept
+    {
+        return this == &Other;
+    }
+
+    void bump_arena::reset()
+    {
+        if (Blocks == nullptr) return;
+        if (Blocks->Next == nullptr) {
+            Current = reinterpret_cast<char*>(Blocks + 1);
+            return;
+        }
+        // Merge all the blocks so that the next batch needs only one
+        std::size_t Bytes = TotalBytes;
+        _release();
+        _add_block(Bytes);
+    }
+
+    std::size_t bump_arena::capacity() const
+    {
+        return TotalBytes;
+    }
+
+    bump_arena& thread_arena()
+    {
+        static thread_local bump_arena Arena;
+        return Arena;
+    }
+
+    limb_vector::limb_vector() : Data(Inline), Resource(get_memory_resource()) {}
+
+    limb_vector::limb_vector(std::pmr::memory_resource* Resource)
+        : Data(Inline), Resource(Resource) {}
+
+    limb_vector::limb_vector(int Count, long long Value)
+        : Data(Inline), Resource(get_memory_resource())
+    {
+        assign(Count, Value);
+    }
+
+    limb_vector::limb_vector(const limb_vector& Other)
+        : Data(Inline), Resource(get_memory_resource())
+    {
+        assign(Other.begin(), Other.end());
+    }
+
+    limb_vector::limb_vector(limb_vector&& Other) noexcept
+        : Data(Inline), Length(Other.Length), Resource(Other.Resource)
+    {
+        // Same resource, so the buffer is taken without allocating
+        if (Other._is_inline()) {
+            std::copy(Other.Data, Other.Data + Other.Length, Data);
+        } else {
+            Data = Other.Data;
+            Capacity = Other.Capacity;
+            Other.Data = Other.Inline;
+            Other.Capacity = InlineElements;
+        }
+        Other.Length = 0;
+    }
+
+    limb_vector::~limb_vector()
+    {
+        _release();
+    }
+
+    long long* limb_vector::_allocate(int Count)
+    {
+        if (Resource == nullptr) return new long long[Count];
+        return static_cast<long long*>(
+            Resource->allocate(Count * sizeof(long long), alignof(long long)));
+    }
+
+    void limb_vector::_release()
+    {
+        if (_is_inline()) return;
+        if (Resource == nullptr) {
+            delete[] Data;
+        } else {
+            Resource->deallocate(Data, Capacity * sizeof(long long), alignof(long long));
+        }
+    }
+
+    limb_vector& limb_vector::operator=(const limb_vector& Other)
+    {
+        if (this != &Other) assign(Other.begin(), Other.end());
+        return (*this);
+    }
+
+    limb_vector& limb_vector::operator=(limb_vector&& Other)
+    {
+        if (this == &Other) return (*this);
+        if (Other._is_inline()) {
+            // Any buffer holds at least "InlineElements" elements
+            std::copy(Other.Data, Other.Data + Other.Length, Data);
+        } else if (Resource != Other.Resource
+                   && (Resource == nullptr || Other.Resource == nullptr
+                       || *Resource != *Other.Resource)) {
+            // The buffer cannot change its resource
+            assign(Other.begin(), Other.end());
+        } else {
+            _release();
+            Data = Other.Data;
+            Capacity = Other.Capacity;
+            Other.Data = Other.Inline;
+            Other.Capacity = InlineElements;
+        }
+        Length = Other.Length;
+        Other.Length = 0;
+        return (*this);
+    }
+
+    bool limb_vector::_is_inline() const
+    {
+        return Data == Inline;
+    }
+
+    std::pmr::memory_resource* limb_vector::resource() const
+    {
+        return Resource;
+    }
+
+    std::size_t limb_vector::size() const
+    {
+        return Length;
+    }
+
+    std::size_t limb_vector::capacity() const
+    {
+        return Capacity;
+    }
+
+    long long* limb_vector::data()
+    {
+        return Data;
+    }
+
+    const long long* limb_vector::data() const
+    {
+        return Data;
+    }
+
+    long long* limb_vector::begin()
+    {
+        return Data;
+    }
+
+    const long long* limb_vector::begin() const
+    {
+        return Data;
+    }
+
+    long long* limb_vector::end()
+    {
+        return Data + Length;
+    }
+
+    const long long* limb_vector::end() const
+    {
+        return Data + Length;
+    }
+
+    long long& limb_vector::operator[](int Index)
+    {
+        return Data[Index];
+    }
+
+    const long long& limb_vector::operator[](int Index) const
+    {
+        return Data[Index];
+    }
+
+    void limb_vector::reserve(int Count)
+    {
+        if (Count <= Capacity) return;
+        int NewCapacity = std::max(Count, 2 * Capacity);
+        long long* NewData = _allocate(NewCapacity);
+        SJTU_INT2048_COUNT(ReallocationCounter);
+        std::copy(Data, Data + Length, NewData);
+        _release();
+        Data = NewData;
+        Capacity = NewCapacity;
+    }
+
+    void limb_vector::resize(int Count, long long Value)
+    {
+        reserve(Count);
+        if (Count > Length) std::fill(Data + Length, Data + Count, Value);
+        Length = Count;
+    }
+
+    void limb_vector::assign(int Count, long long Value)
+    {
+        Length = 0;
+        resize(Count, Value);
+    }
+
+    void limb_vector::assign(const long long* First, const long long* Last)
+    {
+        Length = 0;
+        reserve(Last - First);
+        std::copy(First, Last, Data);
+        Length = Last - First;
+    }
+
+    void limb_vector::clear()
+    {
+        Length = 0;
+    }
+
+    void limb_vector::push_back(long long Value)
+    {
+        if (Length == Capacity) reserve(Length + 1);
+        Data[Length++] = Value;
+    }
+
+    long long* limb_vector::insert(long long* Position, int Count, long long Value)
+    {
+        int Offset = Position - Data;
+        reserve(Length + Count);
+        std::copy_backward(Data + Offset, Data + Length, Data + Length + Count);
+        std::fill(Data + Offset, Data + Offset + Count, Value);
+        Length += Count;
+        return Data + Offset;
+    }
+
+    long long* limb_vector::erase(long long* First, long long* Last)
+    {
+        std::copy(Last, Data + Length, First);
+        Length -= Last - First;
+        return First;
+    }
+
+    void limb_vector::swap(limb_vector& Other)
+    {
+        limb_vector Temp = std::move(Other);
+        Other = std::move(*this);
+        *this = std::move(Temp);
+    }
+
+    int2048::int2048() = default;
+
+    int2048::int2048(long long x)
+    {
+        if (x != 0) {
+            // -x overflows for the lowest long long, its magnitude does not
+            IsPositive = (x > 0);
+            BigInt.resize(3, 0);
+            Size = _split_limbs(BigInt.data(), _integer_magnitude(x));
+        }
+    }
+
+    int2048::int2048(const std::string& String)
+    {
+        read(String);
+    }
+
+    int2048::int2048(const int2048&) = default;
+
+    int2048::int2048(int2048&&) noexcept = default;
+
+    void int2048::read(const std::string& String)
+    {
+        const char* End = String.data() + String.size();
+        std::from_chars_result Result = from_chars(String.data(), End, *this);
+        if (Result.ec != std::errc() || Result.ptr != End) (*this) = 0;
+    }
+
+    void int2048::print() const
+    {
+        std::cout << (*this);
+    }
+
+    int2048 &int2048::_simple_add(const int2048& B)
+    {
+        // B MAY be *this, so its elements are read after the resize
+        if (Size >= B.Size) {
+            BigInt.resize(Size + 1, 0);
+            long long Carry = _add_limbs(BigInt.data(), BigInt.data(), Size,
+                                         B.BigInt.data(), B.Size);
+            BigInt[Size] = Carry;
+            Size += Carry;
+        } else {
+            BigInt.resize(B.Size + 1, 0);
+            long long Carry = _add_limbs(BigInt.data(), B.BigInt.data(), B.Size,
+                                         BigInt.data(), Size);
+            Size = B.Size;
+            BigInt[Size] = Carry;
+            Size += Carry;
+        }
+        return (*this);
+    }
+
+    int2048& int2048::_simple_minus(const int2048& B)
+    {
+        _sub_limbs(BigInt.data(), BigInt.data(), Size, B.BigInt.data(), B.Size);
+        this->_resize();
+        return (*this);
+    }
+
+    int2048& int2048::_reversed_simple_minus(const int2048& B)
+    {
+        BigInt.resize(B.Size, 0);
+        _sub_limbs(BigInt.data(), B.BigInt.data(), B.Size, BigInt.data(), Size);
+        Size = B.Size;
+        this->_resize();
+        return (*this);
+    }
+
+    int2048& int2048::_resize()
+    {
+        while (BigInt[Size - 1] == 0 && Size > 1) {
+            --Size;
+        }
+        return (*this);
+    }
+
+    int2048 &int2048::add(const int2048& B)
+    {
+        return (*this += B);
+    }
+
+    int2048 add(int2048 A, const int2048 &B)
+    {
+        A += B;
+        return A;
+    }
+
+    int2048 &int2048::minus(const int2048& B)
+    {
+        return (*this -= B);
+    }
+
+    int2048 minus(int2048 A, const int2048& B)
+    {
+        A -= B;
+        return A;
+    }
+
+    int2048& addmul(int2048& Answer, const int2048& A, const int2048& B)
+    {
+        return Answer._addmul(A, B, false);
+    }
+
+    int2048& submul(int2048& Answer, const int2048& A, const int2048& B)
+    {
+        return Answer._addmul(A, B, true);
+    }
+
+    int2048& addmul_ui(int2048& Answer, const int2048& A, unsigned long long B)
+    {
+        long long Multiplier[3];
+        int Count = int2048::_split_limbs(Multiplier, B);
+        return Answer._addmul(A.BigInt.data(), A.Size, Multiplier, Count,
+                              A.IsPositive);
+    }
+
+    int2048& submul_ui(int2048& Answer, const int2048& A, unsigned long long B)
+    {
+        long long Multiplier[3];
+        int Count = int2048::_split_limbs(Multiplier, B);
+        return Answer._addmul(A.BigInt.data(), A.Size, Multiplier, Count,
+                              !A.IsPositive);
+    }
+
+    int2048& mul_ui(int2048& Answer, unsigned long long B)
+    {
+        return Answer._single_multiply(B);
+    }
+
+    int2048& int2048::operator=(const int2048&) = default;
+
+    int2048& int2048::operator=(int2048&&) = default;
+
+    int2048& int2048::operator+=(const int2048& B)
+    {
+        SJTU_INT2048_RECORD(Add, std::max(Size, B.Size));
+        if ((IsPositive && B.IsPositive) || (!IsPositive && !B.IsPositive)) {
+            this->_simple_add(B);
+        } else {
+            int Compare = AbsCompare(*this, B);
+            if (Compare == 1) {
+                this->_simple_minus(B);
+            } else if (Compare == 0) {
+                BigInt.assign(1, 0);
+                Size = 1;
+                IsPositive = true;
             } else {
-                IsPositive = false;
-                Size = (String.length() - 2) / MaxDigit + 1;
-                BigInt.resize(Size, 0);
-                int i = String.length() - 1;
-                int Count = 0;
-                while ( i >= MaxDigit) {
-                    for (int j = 0; j < MaxDigit; ++j) {
-                        BigInt[Count] += (String[i - j] - 48) * Power[j];
+                this->_reversed_simple_minus(B);
+                IsPositive = !IsPositive;
+            }
+        }
+        return (*this);
+    }
+
+    int2048 operator+(const int2048& A, const int2048& B)
+    {
+        // Reserve the carry at once, then the copy is the only allocation
+        int2048 Answer;
+        Answer.BigInt.reserve(std::max(A.Size, B.Size) + 1);
+        Answer = A;
+        Answer += B;
+        return Answer;
+    }
+
+    int2048 operator+(int2048&& A, const int2048& B)
+    {
+        A += B;
+        return std::move(A);
+    }
+
+    int2048 operator+(const int2048& A, int2048&& B)
+    {
+        B += A;
+        return std::move(B);
+    }
+
+    int2048 operator+(int2048&& A, int2048&& B)
+    {
+        A += B;
+        return std::move(A);
+    }
+
+    int2048 &int2048::operator-=(const int2048& B)
+    {
+        SJTU_INT2048_RECORD(Subtract, std::max(Size, B.Size));
+        if ((!IsPositive && B.IsPositive) || (IsPositive && !B.IsPositive)) {
+            this->_simple_add(B);
+        } else {
+            int Compare = AbsCompare(*this, B);
+            if (Compare == 1) {
+                this->_simple_minus(B);
+            } else if (Compare == 0) {
+                BigInt.assign(1, 0);
+                Size = 1;
+                IsPositive = true;
+            } else {
+                this->_reversed_simple_minus(B);
+                IsPositive = !IsPositive;
+            }
+        }
+        return (*this);
+    }
+
+    int2048 operator-(const int2048& A, const int2048& B)
+    {
+        int2048 Answer;
+        Answer.BigInt.reserve(std::max(A.Size, B.Size) + 1);
+        Answer = A;
+        Answer -= B;
+        return Answer;
+    }
+
+    int2048 operator-(int2048&& A, const int2048& B)
+    {
+        A -= B;
+        return std::move(A);
+    }
+
+    int2048 operator-(const int2048& A, int2048&& B)
+    {
+        // A - B = -(B - A)
+        B -= A;
+        if (B.Size != 1 || B.BigInt[0] != 0) B.IsPositive = !B.IsPositive;
+        return std::move(B);
+    }
+
+    int2048 operator-(int2048&& A, int2048&& B)
+    {
+        A -= B;
+        return std::move(A);
+    }
+
+    void int2048::_signed_multiply(int2048& Answer, const int2048& A,
+                                   const int2048& B)
+    {
+        SJTU_INT2048_RECORD(Multiply, std::max(A.Size, B.Size));
+        // For the Unsigned Multiplication
+        if (B == 0 || A == 0) {
+            Answer.BigInt.assign(1, 0);
+            Answer.Size = 1;
+            Answer.IsPositive = true;
+            return;
+        }
+
+        Answer.IsPositive = (A.IsPositive == B.IsPositive);
+        _multiply(Answer.BigInt, A.BigInt.data(), A.Size, B.BigInt.data(), B.Size);
+        Answer.Size = A.Size + B.Size;
+        Answer._resize();
+    }
+
+    int2048 &int2048::operator*=(const int2048& B)
+    {
+        // The product cannot be written in place, so it goes to a spare
+        // number kept between calls, which then takes the old buffer.  The
+        // spare outlives any arena, so it only serves operator new
+        static thread_local int2048 Spare = [] {
+            memory_resource_scope Scope(nullptr);
+            return int2048();
+        }();
+        if (BigInt.resource() != nullptr) {
+            memory_resource_scope Scope(BigInt.resource());
+            int2048 Answer;
+            _signed_multiply(Answer, *this, B);
+            return (*this = std::move(Answer));
+        }
+        _signed_multiply(Spare, *this, B);
+        std::swap(*this, Spare);
+        return (*this);
+    }
+
+    int2048 operator*(const int2048& A, const int2048& B)
+    {
+        int2048 Answer;
+        int2048::_signed_multiply(Answer, A, B);
+        return Answer;
+    }
+
+    int2048 operator*(int2048&& A, const int2048& B)
+    {
+        A *= B;
+        return std::move(A);
+    }
+
+    int2048& int2048::sqr()
+    {
+        return (*this *= *this);
+    }
+
+    int2048 square(const int2048& A)
+    {
+        return A * A;
+    }
+
+    int2048 pow(const int2048& Base, unsigned long long Exponent)
+    {
+        long long Bits = 0;
+        while (Bits < 64 && (Exponent >> Bits) != 0) ++Bits;
+        int2048 Answer;
+        int2048::_sliding_window_power(Answer, Base, Bits,
+            [Exponent](long long i) { return (Exponent >> i) & 1; },
+            [](int2048&) {});
+        return Answer;
+    }
+
+    int2048 powmod(const int2048& Base, const int2048& Exponent,
+                   const int2048& Mod)
+    {
+        int2048 Modulus = Mod;
+        Modulus.IsPositive = true;
+
+        // The exponent in base 2^30
+        std::vector<long long> Words;
+        limb_vector Rest;
+        Rest.assign(Exponent.BigInt.data(), Exponent.BigInt.data() + Exponent.Size);
+        int RestSize = Exponent.Size;
+        while (RestSize > 1 || Rest[0] != 0) {
+            Words.push_back(int2048::_div_limbs_small(Rest.data(), RestSize, 1 << 30));
+            while (RestSize > 1 && Rest[RestSize - 1] == 0) --RestSize;
+        }
+        long long Bits = 30LL * Words.size();
+        while (Bits > 0 && ((Words[(Bits - 1) / 30] >> ((Bits - 1) % 30)) & 1) == 0) {
+            --Bits;
+        }
+
+        auto Bit = [&Words](long long i) { return (Words[i / 30] >> (i % 30)) & 1; };
+
+        int2048 Answer;
+        long long Low = Modulus.BigInt[0];
+        if (Bits != 0 && Low % 2 != 0 && Low % 5 != 0) {
+            // A modulus coprime to 10 works on the Montgomery forms
+            montgomery_context Context(Modulus);
+            int2048::_sliding_window_power(Answer, Context.to_montgomery(Base), Bits,
+                Bit, [&Context](int2048& X) { Context._redc(X); });
+            Context._redc(Answer);
+            return Answer;
+        }
+        int2048 Reciprocal = int2048::_reciprocal(Modulus);
+        int2048 Residue = Base % Modulus;
+        if (!Residue.IsPositive) Residue += Modulus;
+        int2048::_sliding_window_power(Answer, Residue, Bits, Bit,
+            [&](int2048& X) { int2048::_barrett_reduce(X, Modulus, Reciprocal); });
+        return Answer;
+    }
+
+    int2048 isqrt(const int2048& A)
+    {
+        return std::move(sqrtrem(A).first);
+    }
+
+    std::pair<int2048, int2048> sqrtrem(const int2048& A)
+    {
+        if (A == 0) return {int2048(0), int2048(0)};
+        int2048 Root;
+        int2048 Power;
+        int2048::_root(Root, Power, A, 2);
+        Power -= A;
+        Power.IsPositive = true;
+        return {std::move(Root), std::move(Power)};
+    }
+
+    int2048 gcd(const int2048& A, const int2048& B)
+    {
+        int2048 First = A;
+        int2048 Second = B;
+        First.IsPositive = true;
+        Second.IsPositive = true;
+        if (First < Second) std::swap(First, Second);
+        int2048::_gcd(First, Second, nullptr);
+        return First;
+    }
+
+    int2048 lcm(const int2048& A, const int2048& B)
+    {
+        if (A == 0 || B == 0) return 0;
+        int2048 Answer = A / gcd(A, B) * B;
+        Answer.IsPositive = true;
+        return Answer;
+    }
+
+    int2048 xgcd(const int2048& A, const int2048& B, int2048& X, int2048& Y)
+    {
+        int2048 First = A;
+        int2048 Second = B;
+        First.IsPositive = true;
+        Second.IsPositive = true;
+        bool Swapped = (First < Second);
+        if (Swapped) std::swap(First, Second);
+        int2048 Matrix[2][2] = {{1, 0}, {0, 1}};
+        int2048::_gcd(First, Second, Matrix);
+
+        // First = Matrix[0][0] * |A| + Matrix[0][1] * |B| before the swap
+        X = std::move(Matrix[0][Swapped ? 1 : 0]);
+        Y = std::move(Matrix[0][Swapped ? 0 : 1]);
+        if (!A.IsPositive) X.IsPositive = !X.IsPositive || X == 0;
+        if (!B.IsPositive) Y.IsPositive = !Y.IsPositive || Y == 0;
+        return First;
+    }
+
+    int2048 invmod(const int2048& A, const int2048& Mod)
+    {
+        int2048 Modulus = Mod;
+        Modulus.IsPositive = true;
+        int2048 Residue = A % Modulus;
+        if (!Residue.IsPositive) Residue += Modulus;
+        int2048 X;
+        int2048 Y;
+        if (xgcd(Residue, Modulus, X, Y) != 1) return 0;
+        X %= Modulus;
+        if (!X.IsPositive) X += Modulus;
+        return X;
+    }
+
+    int2048 iroot(const int2048& A, unsigned long long K)
+    {
+        if (K == 1 || A == 0) return A;
+        int2048 Magnitude = A;
+        Magnitude.IsPositive = true;
+        int2048 Root;
+        int2048 Power;
+        int2048::_root(Root, Power, Magnitude, K);
+        Root.IsPositive = A.IsPositive;
+        return Root;
+    }
+
+    int2048 operator*(const int2048& A, int2048&& B)
+    {
+        B *= A;
+        return std::move(B);
+    }
+
+    int2048 operator*(int2048&& A, int2048&& B)
+    {
+        A *= B;
+        return std::move(A);
+    }
+
+    int2048& int2048::operator/=(const int2048& B)
+    {
+        int2048 Quotient;
+        int2048 Remainder;
+        _divide(Quotient, Remainder, *this, B);
+        bool Sign = (IsPositive == B.IsPositive);
+        *this = std::move(Quotient);
+        IsPositive = Sign || (Size == 1 && BigInt[0] == 0);
+        return (*this);
+    }
+
+    int2048 operator/(const int2048& A, const int2048& B)
+    {
+        return std::move(divmod(A, B).first);
+    }
+
+    int2048 operator/(int2048&& A, const int2048& B)
+    {
+        A /= B;
+        return std::move(A);
+    }
+
+    int2048& int2048::operator%=(const int2048& B)
+    {
+        int2048 Quotient;
+        int2048 Remainder;
+        _divide(Quotient, Remainder, *this, B);
+        bool Sign = IsPositive;
+        *this = std::move(Remainder);
+        IsPositive = Sign || (Size == 1 && BigInt[0] == 0);
+        return (*this);
+    }
+
+    int2048 operator%(const int2048& A, const int2048& B)
+    {
+        return std::move(divmod(A, B).second);
+    }
+
+    int2048 operator%(int2048&& A, const int2048& B)
+    {
+        A %= B;
+        return std::move(A);
+    }
+
+    std::pair<int2048, int2048> divmod(const int2048& A, const int2048& B)
+    {
+        std::pair<int2048, int2048> Answer;
+        int2048& Quotient = Answer.first;
+        int2048& Remainder = Answer.second;
+        int2048::_divide(Quotient, Remainder, A, B);
+        Quotient.IsPositive = (A.IsPositive == B.IsPositive)
+                              || (Quotient.Size == 1 && Quotient.BigInt[0] == 0);
+        Remainder.IsPositive = A.IsPositive
+                               || (Remainder.Size == 1 && Remainder.BigInt[0] == 0);
+        return Answer;
+    }
+
+    void int2048::_batch_evaluate(const batch_job& Job, int2048& Answer)
+    {
+        const int2048& A = *Job.A;
+        const int2048& B = *Job.B;
+        switch (Job.Operation) {
+            case batch_job::Add:
+                Answer = A;
+                Answer += B;
+                break;
+            case batch_job::Subtract:
+                Answer = A;
+                Answer -= B;
+                break;
+            case batch_job::Multiply:
+                _signed_multiply(Answer, A, B);
+                break;
+            case batch_job::Divide:
+            case batch_job::Remainder: {
+                // The other half of the division, thrown away
+                int2048 Spare;
+                if (Job.Operation == batch_job::Divide) {
+                    _divide(Answer, Spare, A, B);
+                    Answer.IsPositive = (A.IsPositive == B.IsPositive)
+                                        || (Answer.Size == 1 && Answer.BigInt[0] == 0);
+                } else {
+                    _divide(Spare, Answer, A, B);
+                    Answer.IsPositive = A.IsPositive
+                                        || (Answer.Size == 1 && Answer.BigInt[0] == 0);
+                }
+                break;
+            }
+        }
+    }
+
+    long long int2048::_batch_cost(const batch_job& Job)
+    {
+        long long ASize = Job.A->Size;
+        long long BSize = Job.B->Size;
+        if (Job.Operation == batch_job::Add || Job.Operation == batch_job::Subtract) {
+            return std::max(ASize, BSize);
+        }
+        // A division costs about as much as the product of the quotient
+        // and the divisor
+        if (Job.Operation != batch_job::Multiply) {
+            ASize = std::max(ASize - BSize + 1, 1LL);
+        }
+        long long Long = std::max(ASize, BSize);
+        long long Short = std::min(ASize, BSize);
+        if (Short < KaratsubaThreshold) return Long * Short;
+        long long Log = 1;
+        while ((1LL << Log) < Short) ++Log;
+        return Long * Log * 16;
+    }
+
+    void batch_eval(const batch_job* Jobs, int Count, int2048* Answers)
+    {
+#ifdef SJTU_INT2048_THREADS
+        if (parallel::thread_pool* Pool = parallel::pool()) {
+            batch_eval(Jobs, Count, Answers, *Pool);
+            return;
+        }
+#endif
+        for (int i = 0; i < Count; ++i) {
+            int2048::_batch_evaluate(Jobs[i], Answers[i]);
+        }
+    }
+
+#ifdef SJTU_INT2048_THREADS
+    void batch_eval(const batch_job* Jobs, int Count, int2048* Answers,
+                    parallel::thread_pool& Pool)
+    {
+        // Longest processing time first: the jobs are sorted by their cost,
+        // then cut into chunks of at least 1 / (8 * threads) of the total,
+        // so a long job is a chunk of its own and short ones are grouped
+        std::vector<long long> Costs(Count);
+        std::vector<int> Order(Count);
+        long long Total = 0;
+        for (int i = 0; i < Count; ++i) {
+            Costs[i] = int2048::_batch_cost(Jobs[i]);
+            Order[i] = i;
+            Total += Costs[i];
+        }
+        std::stable_sort(Order.begin(), Order.end(),
+                         [&](int X, int Y) { return Costs[X] > Costs[Y]; });
+        long long Target = std::max(Total / (8LL * Pool.size()), 1LL);
+        std::vector<int> Chunks(1, 0);
+        long long ChunkCost = 0;
+        for (int i = 0; i < Count; ++i) {
+            ChunkCost += Costs[Order[i]];
+            if (ChunkCost >= Target || i + 1 == Count) {
+                Chunks.push_back(i + 1);
+                ChunkCost = 0;
+            }
+        }
+
+        // Every thread takes the next chunk until there is none left
+        int ChunkCount = (int)Chunks.size() - 1;
+        std::atomic<int> Next{0};
+        auto Work = [&] {
+            for (int Chunk = Next++; Chunk < ChunkCount; Chunk = Next++) {
+                for (int i = Chunks[Chunk]; i < Chunks[Chunk + 1]; ++i) {
+                    int2048::_batch_evaluate(Jobs[Order[i]], Answers[Order[i]]);
+                }
+            }
+        };
+        // The chunks are jobs, so the threads waiting for the pieces of
+        // their multiplications do not start other chunks meanwhile
+        parallel::task_group Group(Pool, true);
+        for (int i = 1; i < std::min(Pool.size(), ChunkCount); ++i) Group.run(Work);
+        Work();
+        Group.wait();
+    }
+#endif
+
+    template <class Integer>
+    unsigned long long _integer_magnitude(Integer A)
+    {
+        if constexpr (std::is_signed_v<Integer>) {
+            if (A < 0) return 0ULL - static_cast<unsigned long long>(A);
+        }
+        return static_cast<unsigned long long>(A);
+    }
+
+    template <class Integer>
+    bool _integer_positive(Integer A)
+    {
+        if constexpr (std::is_signed_v<Integer>) {
+            return A >= 0;
+        } else {
+            return true;
+        }
+    }
+
+    template <class Integer>
+    enable_if_integer<Integer, int2048&> int2048::operator+=(Integer B)
+    {
+        return _add_small(_integer_magnitude(B), _integer_positive(B));
+    }
+
+    template <class Integer>
+    enable_if_integer<Integer, int2048&> int2048::operator-=(Integer B)
+    {
+        return _add_small(_integer_magnitude(B), !_integer_positive(B));
+    }
+
+    template <class Integer>
+    enable_if_integer<Integer, int2048&> int2048::operator*=(Integer B)
+    {
+        return _multiply_small(_integer_magnitude(B), _integer_positive(B));
+    }
+
+    template <class Integer>
+    enable_if_integer<Integer, int2048&> int2048::operator/=(Integer B)
+    {
+        return _divide_small(_integer_magnitude(B), _integer_positive(B), false);
+    }
+
+    template <class Integer>
+    enable_if_integer<Integer, int2048&> int2048::operator%=(Integer B)
+    {
+        return _divide_small(_integer_magnitude(B), _integer_positive(B), true);
+    }
+
+    template <class Integer>
+    enable_if_integer<Integer, int2048> operator+(const int2048& A, Integer B)
+    {
+        int2048 Answer;
+        Answer.BigInt.reserve(std::max(A.Size, 3) + 1);
+        Answer = A;
+        Answer += B;
+        return Answer;
+    }
+
+    template <class Integer>
+    enable_if_integer<Integer, int2048> operator+(int2048&& A, Integer B)
+    {
+        A += B;
+        return std::move(A);
+    }
+
+    template <class Integer>
+    enable_if_integer<Integer, int2048> operator+(Integer A, const int2048& B)
+    {
+        return B + A;
+    }
+
+    template <class Integer>
+    enable_if_integer<Integer, int2048> operator+(Integer A, int2048&& B)
+    {
+        B += A;
+        return std::move(B);
+    }
+
+    template <class Integer>
+    enable_if_integer<Integer, int2048> operator-(const int2048& A, Integer B)
+    {
+        int2048 Answer;
+        Answer.BigInt.reserve(std::max(A.Size, 3) + 1);
+        Answer = A;
+        Answer -= B;
+        return Answer;
+    }
+
+    template <class Integer>
+    enable_if_integer<Integer, int2048> operator-(int2048&& A, Integer B)
+    {
+        A -= B;
+        return std::move(A);
+    }
+
+    template <class Integer>
+    enable_if_integer<Integer, int2048> operator-(Integer A, const int2048& B)
+    {
+        return A - int2048(B);
+    }
+
+    template <class Integer>
+    enable_if_integer<Integer, int2048> operator-(Integer A, int2048&& B)
+    {
+        // A - B = -(B - A)
+        B -= A;
+        if (B.Size != 1 || B.BigInt[0] != 0) B.IsPositive = !B.IsPositive;
+        return std::move(B);
+    }
+
+    template <class Integer>
+    enable_if_integer<Integer, int2048> operator*(const int2048& A, Integer B)
+    {
+        int2048 Answer;
+        Answer.BigInt.reserve(A.Size + 3);
+        Answer = A;
+        Answer *= B;
+        return Answer;
+    }
+
+    template <class Integer>
+    enable_if_integer<Integer, int2048> operator*(int2048&& A, Integer B)
+    {
+        A *= B;
+        return std::move(A);
+    }
+
+    template <class Integer>
+    enable_if_integer<Integer, int2048> operator*(Integer A, const int2048& B)
+    {
+        return B * A;
+    }
+
+    template <class Integer>
+    enable_if_integer<Integer, int2048> operator*(Integer A, int2048&& B)
+    {
+        B *= A;
+        return std::move(B);
+    }
+
+    template <class Integer>
+    enable_if_integer<Integer, int2048> operator/(const int2048& A, Integer B)
+    {
+        int2048 Answer = A;
+        Answer /= B;
+        return Answer;
+    }
+
+    template <class Integer>
+    enable_if_integer<Integer, int2048> operator/(int2048&& A, Integer B)
+    {
+        A /= B;
+        return std::move(A);
+    }
+
+    template <class Integer>
+    enable_if_integer<Integer, int2048> operator%(const int2048& A, Integer B)
+    {
+        unsigned long long Magnitude = _integer_magnitude(B);
+        if (Magnitude == 0 || Magnitude >= (unsigned long long)Max) {
+            int2048 Answer = A;
+            Answer %= B;
+            return Answer;
+        }
+        // Only the remainder is written, not a copy of A
+        int2048 Answer(int2048::_mod_limbs_small(A.BigInt.data(), A.Size,
+                                                 (long long)Magnitude));
+        if (Answer != 0) Answer.IsPositive = A.IsPositive;
+        return Answer;
+    }
+
+    template <class Integer>
+    enable_if_integer<Integer, int2048> operator%(int2048&& A, Integer B)
+    {
+        A %= B;
+        return std::move(A);
+    }
+
+    template <class Integer>
+    enable_if_integer<Integer, bool> operator==(const int2048& A, Integer B)
+    {
+        return A._compare_small(_integer_magnitude(B), _integer_positive(B)) == 0;
+    }
+
+    template <class Integer>
+    enable_if_integer<Integer, bool> operator!=(const int2048& A, Integer B)
+    {
+        return A._compare_small(_integer_magnitude(B), _integer_positive(B)) != 0;
+    }
+
+    template <class Integer>
+    enable_if_integer<Integer, bool> operator<(const int2048& A, Integer B)
+    {
+        return A._compare_small(_integer_magnitude(B), _integer_positive(B)) < 0;
+    }
+
+    template <class Integer>
+    enable_if_integer<Integer, bool> operator>(const int2048& A, Integer B)
+    {
+        return A._compare_small(_integer_magnitude(B), _integer_positive(B)) > 0;
+    }
+
+    template <class Integer>
+    enable_if_integer<Integer, bool> operator<=(const int2048& A, Integer B)
+    {
+        return A._compare_small(_integer_magnitude(B), _integer_positive(B)) <= 0;
+    }
+
+    template <class Integer>
+    enable_if_integer<Integer, bool> operator>=(const int2048& A, Integer B)
+    {
+        return A._compare_small(_integer_magnitude(B), _integer_positive(B)) >= 0;
+    }
+
+    template <class Integer>
+    enable_if_integer<Integer, bool> operator==(Integer A, const int2048& B)
+    {
+        return B == A;
+    }
+
+    template <class Integer>
+    enable_if_integer<Integer, bool> operator!=(Integer A, const int2048& B)
+    {
+        return B != A;
+    }
+
+    template <class Integer>
+    enable_if_integer<Integer, bool> operator<(Integer A, const int2048& B)
+    {
+        return B > A;
+    }
+
+    template <class Integer>
+    enable_if_integer<Integer, bool> operator>(Integer A, const int2048& B)
+    {
+        return B < A;
+    }
+
+    template <class Integer>
+    enable_if_integer<Integer, bool> operator<=(Integer A, const int2048& B)
+    {
+        return B >= A;
+    }
+
+    template <class Integer>
+    enable_if_integer<Integer, bool> operator>=(Integer A, const int2048& B)
+    {
+        return B <= A;
+    }
+
+    void int2048::_divide(int2048& Quotient, int2048& Remainder,
+                          const int2048& A, const int2048& B)
+    {
+        SJTU_INT2048_RECORD(Divide, A.Size);
+        if (AbsCompare(A, B) == -1) {
+            Quotient = 0;
+            Remainder = A;
+            Remainder.IsPositive = true;
+            return;
+        }
+        if (B.Size >= NewtonThreshold && A.Size - B.Size >= NewtonThreshold) {
+            _newton_divide(Quotient, Remainder, A, B);
+        } else {
+            _basecase_divide(Quotient, Remainder, A, B);
+        }
+    }
+
+    void int2048::_basecase_divide(int2048& Quotient, int2048& Remainder,
+                                   const int2048& A, const int2048& B)
+    {
+        // Knuth's Algorithm D
+        int n = B.Size;
+        int m = A.Size - B.Size;
+        limb_vector& Answer = Quotient.BigInt;
+        Quotient.IsPositive = true;
+        Remainder.IsPositive = true;
+        if (n == 1) {
+            Answer.assign(A.BigInt.begin(), A.BigInt.begin() + A.Size);
+            Remainder = _div_limbs_small(Answer.data(), A.Size, B.BigInt[0]);
+            Quotient.Size = A.Size;
+            Quotient._resize();
+            return;
+        }
+
+        // Normalize so that the highest element of the divisor is no less
+        // than Max / 2, then every estimation is at most 2 too large
+        long long Factor = Max / (B.BigInt[n - 1] + 1);
+        limb_vector U(A.Size + 1, 0);
+        limb_vector V(n + 1, 0);
+        U[A.Size] = _mul_limbs_small(U.data(), A.BigInt.data(), A.Size, Factor);
+        V[n] = _mul_limbs_small(V.data(), B.BigInt.data(), n, Factor);
+        Answer.assign(m + 1, 0);
+        for (int j = m; j >= 0; --j) {
+            long long Numerator = U[j + n] * Max + U[j + n - 1];
+            long long Estimate = Numerator / V[n - 1];
+            long long Rest = Numerator % V[n - 1];
+            if (Estimate >= Max) {
+                Estimate = Max - 1;
+                Rest = Numerator - Estimate * V[n - 1];
+            }
+            while (Rest < Max && Estimate * V[n - 2] > Rest * Max + U[j + n - 2]) {
+                --Estimate;
+                Rest += V[n - 1];
+            }
+
+            // U[j, j + n] -= Estimate * V
+            long long Carry = 0;
+            long long Borrow = 0;
+            for (int i = 0; i < n; ++i) {
+                long long Product = Estimate * V[i] + Carry;
+                Carry = Product / Max;
+                U[i + j] -= Product % Max + Borrow;
+                if (U[i + j] < 0) {
+                    U[i + j] += Max;
+                    Borrow = 1;
+                    continue;
+                }
+                Borrow = 0;
+            }
+            U[j + n] -= Carry + Borrow;
+            if (U[j + n] < 0) { // Still one too large, add V back
+                SJTU_INT2048_COUNT(DivisionCorrectionCounter);
+                --Estimate;
+                Carry = 0;
+                for (int i = 0; i < n; ++i) {
+                    U[i + j] += V[i] + Carry;
+                    if (U[i + j] >= Max) {
+                        U[i + j] -= Max;
+                        Carry = 1;
+                        continue;
+                    }
+                    Carry = 0;
+                }
+                U[j + n] += Carry;
+            }
+            Answer[j] = Estimate;
+        }
+        Quotient.Size = m + 1;
+        Quotient._resize();
+
+        _div_limbs_small(U.data(), n, Factor);
+        U.resize(n);
+        Remainder.BigInt.swap(U);
+        Remainder.Size = n;
+        Remainder._resize();
+    }
+
+    void int2048::_newton_divide(int2048& Quotient, int2048& Remainder,
+                                 const int2048& A, const int2048& B)
+    {
+        // Long division in base Max^n, every step divides a number less than
+        // B * Max^n by B through the reciprocal
+        int n = B.Size;
+        int2048 Divisor = B;
+        Divisor.IsPositive = true;
+        int2048 Reciprocal = _reciprocal(Divisor);
+        int Blocks = (A.Size + n - 1) / n;
+        Quotient.BigInt.assign(Blocks * n, 0);
+        Quotient.Size = Blocks * n;
+        Quotient.IsPositive = true;
+        int2048 Rest;
+        for (int i = Blocks - 1; i >= 0; --i) {
+            // Dividend = Rest * Max^n + A[i * n, (i + 1) * n)
+            int End = std::min(A.Size, (i + 1) * n);
+            int2048 Dividend;
+            Dividend.BigInt.assign(n + Rest.Size, 0);
+            std::copy(A.BigInt.begin() + i * n, A.BigInt.begin() + End,
+                      Dividend.BigInt.begin());
+            std::copy(Rest.BigInt.begin(), Rest.BigInt.begin() + Rest.Size,
+                      Dividend.BigInt.begin() + n);
+            Dividend.Size = n + Rest.Size;
+            Dividend._resize();
+
+            int2048 Digit = Dividend * Reciprocal;
+            Digit._shift(-2 * n);
+            Rest = Dividend - Digit * Divisor;
+            while (!Rest.IsPositive) {
+                SJTU_INT2048_COUNT(DivisionCorrectionCounter);
+                Digit -= 1;
+                Rest += Divisor;
+            }
+            while (AbsCompare(Rest, Divisor) != -1) {
+                SJTU_INT2048_COUNT(DivisionCorrectionCounter);
+                Digit += 1;
+                Rest -= Divisor;
+            }
+            std::copy(Digit.BigInt.begin(), Digit.BigInt.begin() + Digit.Size,
+                      Quotient.BigInt.begin() + i * n);
+        }
+        Quotient._resize();
+        Remainder = std::move(Rest);
+    }
+
+    int2048 int2048::_reciprocal(const int2048& B)
+    {
+        int n = B.Size;
+        int2048 Power;
+        Power.BigInt.assign(2 * n + 1, 0);
+        Power.BigInt[2 * n] = 1;
+        Power.Size = 2 * n + 1;
+        if (n < NewtonThreshold) {
+            int2048 Answer;
+            int2048 Remainder;
+            _basecase_divide(Answer, Remainder, Power, B);
+            return Answer;
+        }
+
+        // Start from the reciprocal of the highest limbs, which is accurate
+        // to about 2 * Half - n limbs, and one Newton step
+        // X = X + X * (Max^(2n) - B * X) / Max^(2n) doubles the precision
+        int Half = n / 2 + 2;
+        int2048 High = B;
+        High._shift(Half - n);
+        int2048 Answer = _reciprocal(High);
+        Answer._shift(n - Half);
+        int2048 Error = Power - B * Answer;
+        int2048 Delta = Answer * Error;
+        Delta._shift(-2 * n);
+        Answer += Delta;
+        Error -= B * Delta;
+        while (!Error.IsPositive) {
+            SJTU_INT2048_COUNT(DivisionCorrectionCounter);
+            Answer -= 1;
+            Error += B;
+        }
+        while (AbsCompare(Error, B) != -1) {
+            SJTU_INT2048_COUNT(DivisionCorrectionCounter);
+            Answer += 1;
+            Error -= B;
+        }
+        return Answer;
+    }
+
+    void int2048::_barrett_reduce(int2048& X, const int2048& Mod,
+                                  const int2048& Reciprocal)
+    {
+        // Quotient = floor(floor(X / Max^(n - 1)) * Reciprocal / Max^(n + 1))
+        // is at most 2 less than X / Mod
+        int n = Mod.Size;
+        if (AbsCompare(X, Mod) == -1) return;
+        int2048 Quotient = X;
+        Quotient._shift(1 - n);
+        Quotient *= Reciprocal;
+        Quotient._shift(-1 - n);
+        X._addmul(Quotient, Mod, true);
+        while (AbsCompare(X, Mod) != -1) {
+            SJTU_INT2048_COUNT(DivisionCorrectionCounter);
+            X -= Mod;
+        }
+    }
+
+    void int2048::_root(int2048& Root, int2048& Power, const int2048& A,
+                        unsigned long long K)
+    {
+        int n = A.Size;
+        if (K >= 30ULL * n) { // A < 2^K
+            Root = 1;
+            Power = 1;
+            return;
+        }
+
+        // The root has at least m elements, and the root of A / Max^(K * j)
+        // times Max^j is short of it by less than Max^j, which is far below
+        // its square root, so one Newton step leaves it at most 1 too large
+        long long m = (n - 1) / (long long)K + 1;
+        long long j = (m - 3) / 2;
+        if (j > 0) {
+            int2048 High = A;
+            High._shift(-(int)(K * j));
+            _root(Root, Power, High, K);
+            _root_step(Root, A, K, (int)j);
+            Power = pow(Root, K);
+            if (Power > A) {
+                Root -= 1;
+                if (K == 2) {
+                    // Root^2 = (Root + 1)^2 - 2 * Root - 1
+                    Power -= Root;
+                    Power -= Root;
+                    Power -= 1;
+                } else {
+                    Power = pow(Root, K);
+                }
+            }
+            return;
+        }
+
+        // A short root starts from the floating-point root of the highest
+        // elements, then Newton steps decrease to the root from above
+        int Used = std::min(n, 3);
+        long double High = 0;
+        for (int i = n - 1; i >= n - Used; --i) High = High * Max + A.BigInt[i];
+        long double Log = (std::log10(High) + 9.0L * (n - Used)) / K;
+        if (Log < 17) {
+            Root = (long long)std::pow(10.0L, Log) + 1;
+        } else {
+            long long Exponent = (long long)Log - 17;
+            Root = (long long)std::pow(10.0L, Log - Exponent) + 1;
+            Root *= pow(int2048(10), Exponent);
+        }
+        _root_step(Root, A, K, 0);
+        while (true) {
+            int2048 Next = Root;
+            _root_step(Next, A, K, 0);
+            if (Next >= Root) break;
+            Root = std::move(Next);
+        }
+        Power = pow(Root, K);
+    }
+
+    void int2048::_root_step(int2048& Root, const int2048& A,
+                             unsigned long long K, int Shift)
+    {
+        // A / X^(K - 1) = (A / Max^((K - 1) * Shift)) / Root^(K - 1), so the
+        // divisor is only as long as Root
+        int2048 Dividend = A;
+        Dividend._shift(-(int)((K - 1) * Shift));
+        int2048 Quotient = Dividend / pow(Root, K - 1);
+        Root *= K - 1;
+        Root._shift(Shift);
+        Root += Quotient;
+        Root /= K;
+    }
+
+    void int2048::_gcd(int2048& A, int2048& B, int2048 (*Matrix)[2])
+    {
+        while (!(B.Size == 1 && B.BigInt[0] == 0)) {
+            if (B.Size >= HalfGCDThreshold) {
+                // The half-GCD of the higher third takes about a sixth of
+                // the elements away
+                int2048 Step[2][2] = {{1, 0}, {0, 1}};
+                if (_hgcd_reduce(A, B, A.Size * 2 / 3, Step)) {
+                    if (Matrix != nullptr) {
+                        // Matrix = Step^-1 * Matrix
+                        int2048 Inverse[2][2] = {{Step[1][1], Step[0][1]},
+                                                 {Step[1][0], Step[0][0]}};
+                        Inverse[0][1].IsPositive = (Inverse[0][1] == 0);
+                        Inverse[1][0].IsPositive = (Inverse[1][0] == 0);
+                        _apply_matrix(Inverse, Matrix[0][0], Matrix[1][0]);
+                        _apply_matrix(Inverse, Matrix[0][1], Matrix[1][1]);
+                    }
+                    if (A < B) {
+                        std::swap(A, B);
+                        if (Matrix != nullptr) std::swap(Matrix[0], Matrix[1]);
                     }
-                    i -= MaxDigit;
-                    ++Count;
+                    continue;
+                }
+            }
+            if (Matrix == nullptr && A.Size <= 2) {
+                // The rest fits in machine integers
+                long long X = A.BigInt[0] + (A.Size == 2 ? A.BigInt[1] * Max : 0);
+                long long Y = B.BigInt[0] + (B.Size == 2 ? B.BigInt[1] * Max : 0);
+                while (Y != 0) {
+                    long long Rest = X % Y;
+                    X = Y;
+                    Y = Rest;
+                }
+                A = X;
+                B = 0;
+                return;
+            }
+            if (!_lehmer_step(A, B, Matrix)) _division_step(A, B, Matrix);
+        }
+    }
+
+    bool int2048::_hgcd(int2048& A, int2048& B, int2048 (*M)[2])
+    {
+        // Moller's half-GCD: as both numbers keep more than Stop elements,
+        // the elements of M are less than Max^(n - Stop) <= Max^(Stop - 1),
+        // so the lower elements change the result of M^-1 by less than the
+        // numbers themselves, which stay positive and the steps correct
+        int n = std::max(A.Size, B.Size);
+        int Stop = n / 2 + 1;
+        bool Reduced = false;
+        if (n >= HalfGCDBaseThreshold) {
+            // The higher half, recursively, leaves about 3n / 4 elements
+            Reduced = _hgcd_reduce(A, B, n / 2, M);
+            while (std::max(A.Size, B.Size) > 3 * n / 4 + 1) {
+                if (!_hgcd_step(A, B, Stop, M)) return Reduced;
+                Reduced = true;
+            }
+
+            // Then the higher 2 (Size - Stop) + 1 elements, recursively,
+            // leave little more than Stop elements
+            int Size = std::max(A.Size, B.Size);
+            if (Size > Stop + 2) {
+                int2048 Step[2][2] = {{1, 0}, {0, 1}};
+                if (_hgcd_reduce(A, B, 2 * Stop - Size + 1, Step)) {
+                    _multiply_matrix(M, Step);
+                    Reduced = true;
                 }
-                for (int j = 0; i > 0; ++j) {
-                    BigInt[Count] += (String[i] - 48) * Power[j];
-                    --i;
+            }
+        }
+        while (_hgcd_step(A, B, Stop, M)) Reduced = true;
+        return Reduced;
+    }
+
+    bool int2048::_hgcd_reduce(int2048& A, int2048& B, int Low, int2048 (*M)[2])
+    {
+        int2048 HighA = A;
+        int2048 HighB = B;
+        HighA._shift(-Low);
+        HighB._shift(-Low);
+        if (!_hgcd(HighA, HighB, M)) return false;
+
+        // (A, B) = M^-1 * (A, B), where M^-1 = (M11, -M01; -M10, M00) and
+        // the higher elements are already (HighA, HighB)
+        int ALow = std::min(Low, A.Size);
+        int BLow = std::min(Low, B.Size);
+        HighA._shift(Low);
+        HighA._addmul(M[1][1].BigInt.data(), M[1][1].Size, A.BigInt.data(), ALow, true);
+        HighA._addmul(M[0][1].BigInt.data(), M[0][1].Size, B.BigInt.data(), BLow, false);
+        HighB._shift(Low);
+        HighB._addmul(M[0][0].BigInt.data(), M[0][0].Size, B.BigInt.data(), BLow, true);
+        HighB._addmul(M[1][0].BigInt.data(), M[1][0].Size, A.BigInt.data(), ALow, false);
+        A = std::move(HighA);
+        B = std::move(HighB);
+        return true;
+    }
+
+    bool int2048::_hgcd_step(int2048& A, int2048& B, int Stop, int2048 (*M)[2])
+    {
+        int n = std::max(A.Size, B.Size);
+        if (std::min(A.Size, B.Size) <= Stop) return false;
+
+        // X and Y are A and B divided by 10^Exponent, with 18 digits for the
+        // longer one, but no lower than Max^(Stop - 1)
+        long long Top = std::max(A.Size == n ? A.BigInt[n - 1] : 0,
+                                 B.Size == n ? B.BigInt[n - 1] : 0);
+        long long Exponent = 9LL * (n - 3);
+        for (long long Power = 1; Power <= Top; Power *= 10) ++Exponent;
+        Exponent = std::max(Exponent, 9LL * (Stop - 1));
+        int Low = (int)(Exponent / 9);
+        long long Scale = 1;
+        for (int i = 0; i < Exponent % 9; ++i) Scale *= 10;
+        auto Window = [Low, Scale](const int2048& V) {
+            auto Element = [&V](int i) { return i < V.Size ? V.BigInt[i] : 0LL; };
+            return (Element(Low + 2) * Max + Element(Low + 1)) * (Max / Scale)
+                   + Element(Low) / Scale;
+        };
+        long long X = Window(A);
+        long long Y = Window(B);
+
+        // Subtract while both stay at least Limit, then the cofactors are
+        // below 10^18 / Limit and A, B above (Limit - Max / 2) * 10^Exponent
+        // >= Max^Stop
+        const long long Limit = 2 * Max;
+        long long Step00 = 1;
+        long long Step01 = 0;
+        long long Step10 = 0;
+        long long Step11 = 1;
+        while (X >= Limit && Y >= Limit) {
+            if (X >= Y) {
+                long long Quotient = (X - Limit) / Y;
+                if (Quotient == 0) break;
+                X -= Quotient * Y;
+                Step01 += Quotient * Step00;
+                Step11 += Quotient * Step10;
+            } else {
+                long long Quotient = (Y - Limit) / X;
+                if (Quotient == 0) break;
+                Y -= Quotient * X;
+                Step00 += Quotient * Step01;
+                Step10 += Quotient * Step11;
+            }
+        }
+
+        if (Step01 != 0 || Step10 != 0) {
+            // (A, B) = (Step11 * A - Step01 * B, Step00 * B - Step10 * A) in
+            // one pass, both are positive
+            A.BigInt.resize(n);
+            B.BigInt.resize(n);
+            std::fill(A.BigInt.begin() + A.Size, A.BigInt.end(), 0);
+            std::fill(B.BigInt.begin() + B.Size, B.BigInt.end(), 0);
+            long long CarryA = 0;
+            long long CarryB = 0;
+            for (int i = 0; i < n; ++i) {
+                long long U = A.BigInt[i];
+                long long V = B.BigInt[i];
+                long long TempA = Step11 * U - Step01 * V + CarryA;
+                long long TempB = Step00 * V - Step10 * U + CarryB;
+                CarryA = TempA / Max - (TempA % Max < 0);
+                CarryB = TempB / Max - (TempB % Max < 0);
+                A.BigInt[i] = TempA - CarryA * Max;
+                B.BigInt[i] = TempB - CarryB * Max;
+            }
+            A.Size = n;
+            B.Size = n;
+            A._resize();
+            B._resize();
+            for (int i = 0; i < 2; ++i) {
+                int2048 Left = M[i][0] * Step00;
+                Left += M[i][1] * Step10;
+                M[i][1] = M[i][0] * Step01 + M[i][1] * Step11;
+                M[i][0] = std::move(Left);
+            }
+            return true;
+        }
+
+        // One division of the larger by the smaller, one quotient less if
+        // the remainder is too short
+        bool Swapped = AbsCompare(A, B) == -1;
+        int2048& Larger = Swapped ? B : A;
+        int2048& Smaller = Swapped ? A : B;
+        if ((Larger - Smaller).Size <= Stop) return false;
+        int2048 Quotient;
+        int2048 Remainder;
+        _divide(Quotient, Remainder, Larger, Smaller);
+        if (Remainder.Size <= Stop) {
+            Quotient -= 1;
+            Remainder += Smaller;
+        }
+        Larger = std::move(Remainder);
+        int Column = Swapped ? 0 : 1;
+        for (int i = 0; i < 2; ++i) {
+            M[i][Column]._addmul(Quotient, M[i][1 - Column], false);
+        }
+        return true;
+    }
+
+    void int2048::_multiply_matrix(int2048 (*M)[2], const int2048 (*Step)[2])
+    {
+        for (int i = 0; i < 2; ++i) {
+            int2048 Left = M[i][0] * Step[0][0];
+            Left._addmul(M[i][1], Step[1][0], false);
+            int2048 Right = M[i][0] * Step[0][1];
+            Right._addmul(M[i][1], Step[1][1], false);
+            M[i][0] = std::move(Left);
+            M[i][1] = std::move(Right);
+        }
+    }
+
+    bool int2048::_lehmer_step(int2048& A, int2048& B, int2048 (*Matrix)[2])
+    {
+        // Euclid on X = A / Max^(n - 2) and Y = B / Max^(n - 2), as long as
+        // the quotients from both ends of the ranges of A / B agree
+        // (Knuth's Algorithm L), with cofactors below Max
+        int n = A.Size;
+        if (n < 2 || B.Size < n - 1) return false;
+        long long X = A.BigInt[n - 1] * Max + A.BigInt[n - 2];
+        long long Y = (B.Size == n ? B.BigInt[n - 1] * Max : 0) + B.BigInt[n - 2];
+        long long CofactorA = 1;
+        long long CofactorB = 0;
+        long long CofactorC = 0;
+        long long CofactorD = 1;
+        while (Y + CofactorC != 0 && Y + CofactorD != 0) {
+            long long Quotient = (X + CofactorA) / (Y + CofactorC);
+            if (Quotient != (X + CofactorB) / (Y + CofactorD)) break;
+            if (Quotient >= 2 * Max && CofactorB != 0) break;
+            long long NextC = CofactorA - Quotient * CofactorC;
+            long long NextD = CofactorB - Quotient * CofactorD;
+            if (NextC <= -Max || NextC >= Max || NextD <= -Max || NextD >= Max) break;
+            CofactorA = CofactorC;
+            CofactorB = CofactorD;
+            CofactorC = NextC;
+            CofactorD = NextD;
+            long long Rest = X - Quotient * Y;
+            X = Y;
+            Y = Rest;
+        }
+        if (CofactorB == 0) return false;
+
+        // (A, B) = (CofactorA * A + CofactorB * B, CofactorC * A + CofactorD * B)
+        // in one pass, both are non-negative
+        B.BigInt.resize(n);
+        std::fill(B.BigInt.begin() + B.Size, B.BigInt.end(), 0);
+        long long CarryA = 0;
+        long long CarryB = 0;
+        for (int i = 0; i < n; ++i) {
+            long long U = A.BigInt[i];
+            long long V = B.BigInt[i];
+            long long TempA = CofactorA * U + CofactorB * V + CarryA;
+            long long TempB = CofactorC * U + CofactorD * V + CarryB;
+            CarryA = TempA / Max - (TempA % Max < 0);
+            CarryB = TempB / Max - (TempB % Max < 0);
+            A.BigInt[i] = TempA - CarryA * Max;
+            B.BigInt[i] = TempB - CarryB * Max;
+        }
+        B.Size = n;
+        A._resize();
+        B._resize();
+
+        if (Matrix != nullptr) {
+            for (int j = 0; j < 2; ++j) {
+                int2048 Top = Matrix[0][j] * CofactorA;
+                Top += Matrix[1][j] * CofactorB;
+                Matrix[1][j] = Matrix[0][j] * CofactorC + Matrix[1][j] * CofactorD;
+                Matrix[0][j] = std::move(Top);
+            }
+        }
+        return true;
+    }
+
+    void int2048::_division_step(int2048& A, int2048& B, int2048 (*Matrix)[2])
+    {
+        int2048 Quotient;
+        int2048 Remainder;
+        _divide(Quotient, Remainder, A, B);
+        A = std::move(B);
+        B = std::move(Remainder);
+        if (Matrix != nullptr) {
+            for (int j = 0; j < 2; ++j) {
+                std::swap(Matrix[0][j], Matrix[1][j]);
+                Matrix[1][j]._addmul(Quotient, Matrix[0][j], true);
+            }
+        }
+    }
+
+    void int2048::_apply_matrix(const int2048 (*Step)[2], int2048& X, int2048& Y)
+    {
+        int2048 NewX = Step[0][0] * X;
+        NewX._addmul(Step[0][1], Y, false);
+        int2048 NewY = Step[1][0] * X;
+        NewY._addmul(Step[1][1], Y, false);
+        X = std::move(NewX);
+        Y = std::move(NewY);
+    }
+
+    int2048& int2048::_truncate(int Count)
+    {
+        if (Size > Count) {
+            BigInt.resize(Count);
+            Size = Count;
+            _resize();
+        }
+        return (*this);
+    }
+
+    montgomery_context::montgomery_context(const int2048& Mod) : Mod(Mod)
+    {
+        this->Mod.IsPositive = true;
+        int n = this->Mod.Size;
+
+        // 1 / Mod modulo Max by the extended Euclidean algorithm
+        long long A = this->Mod.BigInt[0];
+        long long B = Max;
+        long long X = 1; // A = X * Mod[0] modulo Max
+        long long Y = 0; // B = Y * Mod[0] modulo Max
+        while (B != 0) {
+            long long Quotient = A / B;
+            long long Temp = A - Quotient * B;
+            A = B;
+            B = Temp;
+            Temp = X - Quotient * Y;
+            X = Y;
+            Y = Temp;
+        }
+        X = (X % Max + Max) % Max;
+        Inverse = (Max - X) % Max;
+
+        // 1 / Mod modulo Max^Length by Newton (Hensel) steps
+        // X = X * (2 - Mod * X), each doubling the number of correct elements
+        int2048 Answer = X;
+        for (int Length = 1; Length < n;) {
+            Length = std::min(2 * Length, n);
+            int2048 Power = 1;
+            Power._shift(Length);
+            int2048 Low = this->Mod;
+            Low._truncate(Length);
+            int2048 Product = Low * Answer;
+            Product._truncate(Length);
+            Answer *= Power + 2 - Product;
+            Answer._truncate(Length);
+        }
+        int2048 R = 1;
+        R._shift(n);
+        InverseR = R - Answer;
+
+        RSquared = 1;
+        RSquared._shift(2 * n);
+        RSquared %= this->Mod;
+    }
+
+    const int2048& montgomery_context::modulus() const
+    {
+        return Mod;
+    }
+
+    int2048 montgomery_context::to_montgomery(const int2048& A) const
+    {
+        int2048 Answer = A;
+        if (!Answer.IsPositive || AbsCompare(Answer, Mod) != -1) {
+            Answer %= Mod;
+            if (!Answer.IsPositive) Answer += Mod;
+        }
+        Answer *= RSquared;
+        _redc(Answer);
+        return Answer;
+    }
+
+    int2048 montgomery_context::from_montgomery(const int2048& A) const
+    {
+        return redc(A);
+    }
+
+    int2048 montgomery_context::redc(const int2048& T) const
+    {
+        int2048 Answer = T;
+        _redc(Answer);
+        return Answer;
+    }
+
+    int2048 montgomery_context::mulmod(const int2048& A, const int2048& B) const
+    {
+        int2048 Answer = A * B;
+        _redc(Answer);
+        return Answer;
+    }
+
+    int2048 montgomery_context::sqrmod(const int2048& A) const
+    {
+        int2048 Answer = square(A);
+        _redc(Answer);
+        return Answer;
+    }
+
+    void montgomery_context::_redc(int2048& T) const
+    {
+        int n = Mod.Size;
+        if (n < KaratsubaThreshold) {
+            // Clear one element at a time by adding Digit * Mod * Max^i
+            T.BigInt.resize(2 * n + 1);
+            std::fill(T.BigInt.begin() + T.Size, T.BigInt.end(), 0);
+            for (int i = 0; i < n; ++i) {
+                long long Digit = T.BigInt[i] * Inverse % Max;
+                int2048::_addmul_limbs(T.BigInt.data() + i, 2 * n + 1 - i,
+                                       Mod.BigInt.data(), n, &Digit, 1);
+            }
+            T.Size = 2 * n + 1;
+            T._resize();
+        } else {
+            // T += (T * InverseR mod R) * Mod, which is a multiple of R
+            int2048 Digits = T;
+            Digits._truncate(n);
+            Digits *= InverseR;
+            Digits._truncate(n);
+            T._addmul(Digits, Mod, false);
+        }
+        T._shift(-n);
+        if (AbsCompare(T, Mod) != -1) T -= Mod;
+    }
+
+    barrett_context::barrett_context(const int2048& Mod) : Mod(Mod)
+    {
+        this->Mod.IsPositive = true;
+        Reciprocal = int2048::_reciprocal(this->Mod);
+    }
+
+    const int2048& barrett_context::modulus() const
+    {
+        return Mod;
+    }
+
+    int2048 barrett_context::reduce(const int2048& A) const
+    {
+        int2048 Answer = A;
+        if (Answer.Size > 2 * Mod.Size) {
+            Answer %= Mod;
+        } else {
+            Answer.IsPositive = true;
+            int2048::_barrett_reduce(Answer, Mod, Reciprocal);
+            Answer.IsPositive = A.IsPositive;
+        }
+        if (!Answer.IsPositive && !(Answer.Size == 1 && Answer.BigInt[0] == 0)) {
+            Answer += Mod;
+        }
+        Answer.IsPositive = true;
+        return Answer;
+    }
+
+    int2048 barrett_context::mulmod(const int2048& A, const int2048& B) const
+    {
+        int2048 Answer = A * B;
+        int2048::_barrett_reduce(Answer, Mod, Reciprocal);
+        return Answer;
+    }
+
+    int2048 barrett_context::sqrmod(const int2048& A) const
+    {
+        int2048 Answer = square(A);
+        int2048::_barrett_reduce(Answer, Mod, Reciprocal);
+        return Answer;
+    }
+
+    template <class BitFunction, class ReduceFunction>
+    void int2048::_sliding_window_power(int2048& Answer, const int2048& Base,
+                                        long long Bits, BitFunction Bit,
+                                        ReduceFunction Reduce)
+    {
+        Answer = 1;
+        if (Bits == 0) {
+            Reduce(Answer);
+            return;
+        }
+
+        // Table[i] = Base ^ (2 * i + 1)
+        int Window = (Bits > 671) ? 6 : (Bits > 239) ? 5 : (Bits > 79) ? 4
+                   : (Bits > 23) ? 3 : (Bits > 7) ? 2 : 1;
+        std::vector<int2048> Table(1 << (Window - 1));
+        Table[0] = Base;
+        if (Window > 1) {
+            int2048 Square = square(Base);
+            Reduce(Square);
+            for (int i = 1; i < (int)Table.size(); ++i) {
+                Table[i] = Table[i - 1] * Square;
+                Reduce(Table[i]);
+            }
+        }
+
+        bool First = true;
+        for (long long i = Bits - 1; i >= 0;) {
+            if (!Bit(i)) {
+                Answer.sqr();
+                Reduce(Answer);
+                --i;
+                continue;
+            }
+            // The longest window [j, i] of at most "Window" bits ending in 1
+            long long j = std::max(i - Window + 1, 0LL);
+            while (!Bit(j)) ++j;
+            int Value = 0;
+            for (long long k = i; k >= j; --k) Value = 2 * Value + (int)Bit(k);
+            if (First) {
+                Answer = Table[Value / 2];
+                First = false;
+            } else {
+                for (long long k = i; k >= j; --k) {
+                    Answer.sqr();
+                    Reduce(Answer);
                 }
+                Answer *= Table[Value / 2];
+                Reduce(Answer);
             }
+            i = j - 1;
+        }
+    }
+
+    int2048& int2048::_shift(int Count)
+    {
+        if (Size == 1 && BigInt[0] == 0) return (*this);
+        if (Count >= 0) {
+            BigInt.resize(Size);
+            BigInt.insert(BigInt.begin(), Count, 0);
+            Size += Count;
+        } else if (-Count >= Size) {
+            BigInt.assign(1, 0);
+            Size = 1;
+            IsPositive = true;
+        } else {
+            BigInt.erase(BigInt.begin(), BigInt.begin() - Count);
+            Size += Count;
+        }
+        return (*this);
+    }
+
+    std::istream& operator>>(std::istream& InStream, int2048& Object)
+    {
+        // The buffer is kept between calls to avoid allocating memory
+        static thread_local std::string Buffer;
+        if (!(InStream >> Buffer)) return InStream;
+        const char* End = Buffer.data() + Buffer.size();
+        int2048 Temp;
+        std::from_chars_result Result = from_chars(Buffer.data(), End, Temp);
+        if (Result.ec != std::errc() || Result.ptr != End) {
+            InStream.setstate(std::ios::failbit);
+        } else {
+            Object = std::move(Temp);
+        }
+        return InStream;
+    }
+
+    std::from_chars_result from_chars(const char* First, const char* Last,
+                                      int2048& Object)
+    {
+        SJTU_INT2048_RECORD(Read, (Last - First) / MaxDigit + 1);
+        const char* Begin = First;
+        bool IsPositive = true;
+        if (First != Last && *First == '-') {
+            IsPositive = false;
+            ++First;
+        }
+        const char* Digits = First;
+        while (Last - First >= 8 && int2048::_is_eight_digits(First)) {
+            First += 8;
+        }
+        while (First != Last && '0' <= *First && *First <= '9') ++First;
+        if (First == Digits) return {Begin, std::errc::invalid_argument};
+        while (Digits + 1 != First && *Digits == '0') ++Digits;
+
+        // Every element but the highest one is 1 + 8 digits
+        long long Length = First - Digits;
+        Object.Size = (Length - 1) / MaxDigit + 1;
+        Object.BigInt.resize(Object.Size);
+        const char* Current = First;
+        for (int i = 0; i < Object.Size - 1; ++i) {
+            Current -= MaxDigit;
+            Object.BigInt[i] = (Current[0] - '0') * Power[8]
+                             + int2048::_parse_eight_digits(Current + 1);
+        }
+        long long Highest = 0;
+        for (const char* i = Digits; i != Current; ++i) {
+            Highest = Highest * 10 + (*i - '0');
+        }
+        Object.BigInt[Object.Size - 1] = Highest;
+        Object.IsPositive = IsPositive || (Object.Size == 1 && Highest == 0);
+        return {First, std::errc()};
+    }
+
+    bool int2048::_is_eight_digits(const char* Chars)
+    {
+        unsigned long long Value;
+        std::memcpy(&Value, Chars, 8);
+        // Every byte is in [0x30, 0x39] iff its high nibble is 3 and adding
+        // 6 to it keeps the high nibble 3
+        return ((Value & 0xF0F0F0F0F0F0F0F0ULL)
+                | (((Value + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4))
+               == 0x3333333333333333ULL;
+    }
+
+    long long int2048::_parse_eight_digits(const char* Chars)
+    {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        // SWAR: combine the digits into 4 pairs, then 2 quadruples, then one
+        unsigned long long Value;
+        std::memcpy(&Value, Chars, 8);
+        Value -= 0x3030303030303030ULL;
+        Value = Value * 10 + (Value >> 8);
+        Value = (((Value & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32)))
+                 + (((Value >> 16) & 0x000000FF000000FFULL)
+                    * (1 + (10000ULL << 32)))) >> 32;
+        return (long long)Value;
+#else
+        long long Value = 0;
+        for (int i = 0; i < 8; ++i) Value = Value * 10 + (Chars[i] - '0');
+        return Value;
+#endif
+    }
+
+    std::ostream& operator<<(std::ostream& OutStream, const int2048& Object)
+    {
+        // The buffer is kept between calls to avoid allocating memory
+        static thread_local std::vector<char> Buffer;
+        std::size_t Length = (std::size_t)Object.Size * MaxDigit + 1;
+        if (Buffer.size() < Length) Buffer.resize(Length);
+        char* End = to_chars(Buffer.data(), Buffer.data() + Length, Object).ptr;
+        OutStream.write(Buffer.data(), End - Buffer.data());
+        return OutStream;
+    }
+
+    std::to_chars_result to_chars(char* First, char* Last, const int2048& Object)
+    {
+        SJTU_INT2048_RECORD(Print, Object.Size);
+        // The highest element is printed without leading zeros
+        char Head[MaxDigit];
+        int HeadLength = 0;
+        long long Top = Object.BigInt[Object.Size - 1];
+        do {
+            Head[HeadLength++] = char('0' + Top % 10);
+            Top /= 10;
+        } while (Top != 0);
+        long long Length = HeadLength + (long long)(Object.Size - 1) * MaxDigit
+                         + (Object.IsPositive ? 0 : 1);
+        if (Last - First < Length) return {Last, std::errc::value_too_large};
+
+        if (!Object.IsPositive) *(First++) = '-';
+        while (HeadLength > 0) *(First++) = Head[--HeadLength];
+        for (int i = Object.Size - 2; i >= 0; --i) {
+            int2048::_print_element(First, Object.BigInt[i]);
+            First += MaxDigit;
+        }
+        return {First, std::errc()};
+    }
+
+    void int2048::_print_element(char* Buffer, long long Element)
+    {
+        // 1 + 4 + 4 digits, and every 4 digits are two pairs
+        int Low = Element % 100000000;
+        int High = Low / 10000;
+        Low %= 10000;
+        Buffer[0] = char('0' + Element / 100000000);
+        std::memcpy(Buffer + 1, DigitPairs + 2 * (High / 100), 2);
+        std::memcpy(Buffer + 3, DigitPairs + 2 * (High % 100), 2);
+        std::memcpy(Buffer + 5, DigitPairs + 2 * (Low / 100), 2);
+        std::memcpy(Buffer + 7, DigitPairs + 2 * (Low % 100), 2);
+    }
+
+    bool operator==(const int2048& A, const int2048& B)
+    {
+        if ((A.IsPositive && B.IsPositive) || (!A.IsPositive && !B.IsPositive)) {
+            if (AbsCompare(A, B) == 0) return true;
+        }
+        return false;
+    }
+
+    bool operator!=(const int2048& A, const int2048& B)
+    {
+        return (!(A == B));
+    }
+
+    bool operator<(const int2048& A, const int2048& B)
+    {
+        if (A.IsPositive && !B.IsPositive) return false;
+        if (!A.IsPositive && B.IsPositive) return true;
+        if (A.IsPositive) {
+            if (AbsCompare(A, B) == -1) return true;
+            else return false;
         } else {
-            IsPositive = true;
-            Size = (String.length() - 1) / MaxDigit + 1;
-            BigInt.resize(Size, 0);
-            int i = String.length() - 1;
-            int Count = 0;
-            while ( i >= MaxDigit - 1) {
-                for (int j = 0; j < MaxDigit; ++j) {
-                    BigInt[Count] += (String[i - j] - 48) * Power[j];
-                }
-                i -= MaxDigit;
-                ++Count;
+            if (AbsCompare(A, B) == 1) return true;
+            else return false;
+        }
+    }
+
+    bool operator>(const int2048& A, const int2048& B)
+    {
+        if (A.IsPositive && !B.IsPositive) return true;
+        if (!A.IsPositive && B.IsPositive) return false;
+        if (A.IsPositive) {
+            if (AbsCompare(A, B) == 1) return true;
+            else return false;
+        } else {
+            if (AbsCompare(A, B) == -1) return true;
+            else return false;
+        }
+    }
+
+    bool operator<=(const int2048& A, const int2048& B)
+    {
+        if (A.IsPositive && !B.IsPositive) return false;
+        if (!A.IsPositive && B.IsPositive) return true;
+        if (A.IsPositive) {
+            if (AbsCompare(A, B) == 1) return false;
+            else return true;
+        } else {
+            if (AbsCompare(A, B) == -1) return false;
+            else return true;
+        }
+    }
+
+    bool operator>=(const int2048& A, const int2048& B)
+    {
+        if (A.IsPositive && !B.IsPositive) return true;
+        if (!A.IsPositive && B.IsPositive) return false;
+        if (A.IsPositive) {
+            if (AbsCompare(A, B) == -1) return false;
+            else return true;
+        } else {
+            if (AbsCompare(A, B) == 1) return false;
+            else return true;
+        }
+    }
+
+    /**
+     * @brief To Compare the ABS of A and B
+     * @param A
+     * @param B
+     * @return If |A| = |B|, return 0.
+     * If |A| > |B|, return 1.
+     * If |A| < |B|, return -1.
+     */
+    int AbsCompare(const int2048& A, const int2048& B)
+    {
+        if (A.Size != B.Size) {
+            if (A.Size > B.Size) return 1;
+            else return -1;
+        }
+        return int2048::_compare_n(A.BigInt.data(), B.BigInt.data(), A.Size);
+    }
+
+    /**
+     * @brief To Multiply a "BigInt" by an "unsigned long long int" in place
+     * @param A the unsigned long long int
+     * @return *this
+     */
+    int2048& int2048::_single_multiply(unsigned long long A)
+    {
+        long long Multiplier[3];
+        int Count = _split_limbs(Multiplier, A);
+        if (Count == 1) {
+            long long Carry = _mul_limbs_small(BigInt.data(), BigInt.data(),
+                                               Size, Multiplier[0]);
+            if (Carry != 0) {
+                BigInt.resize(Size + 1);
+                BigInt[Size++] = Carry;
             }
-            for (int j = 0; i >= 0; ++j) {
-                BigInt[Count] += (String[i] - 48) * Power[j];
-                --i;
+        } else {
+            // Element i of the product is A[i] * Multiplier[0]
+            // + A[i - 1] * Multiplier[1] + A[i - 2] * Multiplier[2] + Carry,
+            // so only the last two elements of A are kept aside
+            if (Count == 2) Multiplier[2] = 0;
+            BigInt.resize(Size + 3);
+            long long* Data = BigInt.data();
+            long long Previous = 0, BeforePrevious = 0, Carry = 0;
+            for (int i = 0; i < Size + 2; ++i) {
+                long long Current = (i < Size) ? Data[i] : 0;
+                long long Temp = Current * Multiplier[0] + Previous * Multiplier[1]
+                               + BeforePrevious * Multiplier[2] + Carry;
+                Carry = Temp / Max;
+                Data[i] = Temp % Max;
+                BeforePrevious = Previous;
+                Previous = Current;
             }
+            Data[Size + 2] = Carry;
+            Size += 3;
         }
+        _resize();
+        if (Size == 1 && BigInt[0] == 0) IsPositive = true;
+        return (*this);
     }
 
-    void int2048::print() const
+    int int2048::_split_limbs(long long* Answer, unsigned long long A)
     {
-        std::cout << (*this);
+        int Count = 0;
+        do {
+            Answer[Count++] = (long long)(A % Max);
+            A /= Max;
+        } while (A != 0);
+        return Count;
     }
 
-    int2048 &int2048::_simple_add(const int2048& B)
+    int2048& int2048::_add_small(unsigned long long BMagnitude, bool BPositive)
     {
-        if (Size > B.Size) {
-            BigInt.resize(Size + 1, 0);
-            bool Carry = false;
-            for (int i = 0; i < B.Size; ++i) {
-                BigInt[i] = BigInt[i] + B.BigInt[i] + Carry;
-                if (BigInt[i] >= Max) {
-                    BigInt[i] -= Max;
-                    Carry = true;
-                    continue;
-                }
-                Carry = false;
+        SJTU_INT2048_RECORD(Add, Size);
+        if (BMagnitude == 0) return (*this);
+        long long B[3];
+        int BSize = _split_limbs(B, BMagnitude);
+        if (Size == 1 && BigInt[0] == 0) IsPositive = BPositive;
+        if (IsPositive == BPositive) {
+            // The carry stops at the first element that does not overflow
+            int Length = std::max(Size, BSize);
+            if ((int)BigInt.size() <= Length) BigInt.resize(Length + 1);
+            std::fill(BigInt.begin() + Size, BigInt.begin() + Length + 1, 0);
+            long long Carry = 0;
+            int i = 0;
+            for (; i < BSize || Carry != 0; ++i) {
+                long long Temp = BigInt[i] + (i < BSize ? B[i] : 0) + Carry;
+                Carry = (Temp >= Max);
+                BigInt[i] = Carry ? Temp - Max : Temp;
             }
-            for (int i = B.Size; i < Size; ++i) {
-                BigInt[i] = BigInt[i] + Carry;
-                if (BigInt[i] >= Max) {
-                    BigInt[i] -= Max;
-                    Carry = true;
-                    continue;
-                }
-                Carry = false;
+            Size = std::max(Length, i);
+        } else if (Size > BSize) {
+            // |*this| > |B|, and the borrow stops likewise
+            long long Borrow = 0;
+            for (int i = 0; i < BSize || Borrow != 0; ++i) {
+                long long Temp = BigInt[i] - (i < BSize ? B[i] : 0) - Borrow;
+                Borrow = (Temp < 0);
+                BigInt[i] = Borrow ? Temp + Max : Temp;
             }
-            if (Carry) { // The case when the biggest digit has a carry
-                BigInt[Size] = 1;
-                ++Size;
+            _resize();
+        } else {
+            _add_signed_limbs(B, BSize, BPositive);
+        }
+        return (*this);
+    }
+
+    int2048& int2048::_multiply_small(unsigned long long BMagnitude, bool BPositive)
+    {
+        SJTU_INT2048_RECORD(Multiply, Size);
+        if (!BPositive) IsPositive = !IsPositive;
+        return _single_multiply(BMagnitude);
+    }
+
+    int2048& int2048::_divide_small(unsigned long long BMagnitude, bool BPositive,
+                                    bool Remainder)
+    {
+        if (BMagnitude == 0 || BMagnitude >= (unsigned long long)Max) {
+            // Still no more than three elements, so no allocation
+            int2048 B;
+            B.BigInt.resize(3);
+            B.Size = _split_limbs(B.BigInt.data(), BMagnitude);
+            B.IsPositive = BPositive || BMagnitude == 0;
+            return Remainder ? (*this %= B) : (*this /= B);
+        }
+        SJTU_INT2048_RECORD(Divide, Size);
+        if (Remainder) {
+            BigInt[0] = _mod_limbs_small(BigInt.data(), Size, (long long)BMagnitude);
+            Size = 1;
+        } else {
+            _div_limbs_small(BigInt.data(), Size, (long long)BMagnitude);
+            if (!BPositive) IsPositive = !IsPositive;
+            _resize();
+        }
+        if (Size == 1 && BigInt[0] == 0) IsPositive = true;
+        return (*this);
+    }
+
+    int int2048::_compare_small(unsigned long long BMagnitude, bool BPositive) const
+    {
+        if (BMagnitude == 0) BPositive = true;
+        if (IsPositive != BPositive) return IsPositive ? 1 : -1;
+        // Max^3 is more than any unsigned long long
+        int Compare = 0;
+        if (Size > 3) {
+            Compare = 1;
+        } else {
+            long long B[3];
+            int BSize = _split_limbs(B, BMagnitude);
+            if (Size != BSize) Compare = (Size > BSize) ? 1 : -1;
+            for (int i = Size - 1; Compare == 0 && i >= 0; --i) {
+                if (BigInt[i] != B[i]) Compare = (BigInt[i] > B[i]) ? 1 : -1;
             }
+        }
+        return IsPositive ? Compare : -Compare;
+    }
+
+    void int2048::_multiply(limb_vector& Answer,
+                            const long long* A, int ASize,
+                            const long long* B, int BSize)
+    {
+        Answer.assign(ASize + BSize, 0);
+        if (A == B && ASize == BSize && ASize < SquareKaratsubaThreshold) {
+            _schoolbook_square(Answer.data(), A, ASize);
+        } else if (std::min(ASize, BSize) < KaratsubaThreshold) {
+            _schoolbook_multiply(Answer.data(), A, ASize, B, BSize);
+        } else if (std::min(ASize, BSize) < NTTThreshold) {
+            // The scratch is kept between calls to avoid allocating memory
+            static thread_local std::vector<long long> Scratch;
+            int ScratchSize = _multiply_scratch_size(std::max(ASize, BSize));
+            if ((int)Scratch.size() < ScratchSize) Scratch.resize(ScratchSize);
+            _multiply_recursive(Answer.data(), A, ASize, B, BSize,
+                                Scratch.data());
         } else {
-            Size = B.Size;
-            BigInt.resize(Size + 1, 0);
-            bool Carry = false;
-            for (int i = 0; i < Size; ++i) {
-                BigInt[i] = BigInt[i] + B.BigInt[i] + Carry;
-                if (BigInt[i] >= Max) {
-                    BigInt[i] -= Max;
-                    Carry = true;
-                    continue;
-                }
-                Carry = false;
+            _ntt_multiply(Answer.data(), A, ASize, B, BSize);
+        }
+    }
+
+    void int2048::_multiply_recursive(long long* Answer,
+                                      const long long* A, int ASize,
+                                      const long long* B, int BSize,
+                                      long long* Scratch)
+    {
+        if (ASize < BSize) {
+            std::swap(A, B);
+            std::swap(ASize, BSize);
+        }
+        // The recursion keeps A == B for squares, down to _schoolbook_square
+        bool Square = (A == B && ASize == BSize);
+        if (Square && ASize < SquareKaratsubaThreshold) {
+            std::fill(Answer, Answer + 2 * ASize, 0);
+            _schoolbook_square(Answer, A, ASize);
+        } else if (BSize < KaratsubaThreshold) {
+            std::fill(Answer, Answer + ASize + BSize, 0);
+            _schoolbook_multiply(Answer, A, ASize, B, BSize);
+        } else if (BSize >= Toom3Threshold && BSize > 2 * ((ASize + 2) / 3)) {
+            _toom3_multiply(Answer, A, ASize, B, BSize, Scratch);
+        } else if (BSize > (ASize + 1) / 2) {
+            _karatsuba_multiply(Answer, A, ASize, B, BSize, Scratch);
+        } else {
+            // Unbalanced: cut A into pieces as long as B
+            long long* Temp = Scratch;
+            long long* Next = Scratch + 2 * BSize;
+            _multiply_recursive(Answer, A, BSize, B, BSize, Next);
+            for (int Offset = BSize; Offset < ASize; Offset += BSize) {
+                int Length = std::min(BSize, ASize - Offset);
+                _multiply_recursive(Temp, A + Offset, Length, B, BSize, Next);
+                std::fill(Answer + Offset + BSize,
+                          Answer + Offset + BSize + Length, 0);
+                _accumulate(Answer + Offset, Length + BSize, Temp, Length + BSize);
             }
-            if (Carry) { // The case when the biggest digit has a carry
-                BigInt[Size] = 1;
-                ++Size;
+        }
+    }
+
+    void int2048::_karatsuba_multiply(long long* Answer,
+                                      const long long* A, int ASize,
+                                      const long long* B, int BSize,
+                                      long long* Scratch)
+    {
+        // A = A1 * Max^Half + A0, B = B1 * Max^Half + B0
+        int Half = (ASize + 1) / 2;
+        long long* SumA = Scratch;
+        long long* SumB = SumA + Half + 1;
+        long long* Middle = SumB + Half + 1;
+        long long* Next = Middle + 2 * Half + 2;
+
+        _multiply_recursive(Answer, A, Half, B, Half, Scratch);
+        _multiply_recursive(Answer + 2 * Half, A + Half, ASize - Half,
+                            B + Half, BSize - Half, Scratch);
+
+        // Middle = (A0 + A1) * (B0 + B1) - A0 * B0 - A1 * B1
+        SumA[Half] = _add_limbs(SumA, A, Half, A + Half, ASize - Half);
+        if (A == B) {
+            SumB = SumA;
+        } else {
+            SumB[Half] = _add_limbs(SumB, B, Half, B + Half, BSize - Half);
+        }
+        _multiply_recursive(Middle, SumA, Half + 1, SumB, Half + 1, Next);
+        _sub_limbs(Middle, Middle, 2 * Half + 2, Answer, 2 * Half);
+        _sub_limbs(Middle, Middle, 2 * Half + 2,
+                   Answer + 2 * Half, ASize + BSize - 2 * Half);
+        _accumulate(Answer + Half, ASize + BSize - Half, Middle, 2 * Half + 2);
+    }
+
+    void int2048::_toom3_multiply(long long* Answer,
+                                  const long long* A, int ASize,
+                                  const long long* B, int BSize,
+                                  long long* Scratch)
+    {
+        // A = A2 * X^2 + A1 * X + A0 with X = Max^Third, so is B.
+        // The product is C4 * X^4 + ... + C0, which is found by its values
+        // W(0), W(1), W(2), W(3) and W(inf), where G(x) = W(x) - C4 * x^4 is
+        // a cubic with non-negative coefficients, so all its forward
+        // differences are non-negative as well.
+        int Third = (ASize + 2) / 3;
+        int Length = 2 * Third + 2; // the length of every W(x)
+        int A2Size = ASize - 2 * Third;
+        int B2Size = BSize - 2 * Third;
+        int C4Size = A2Size + B2Size;
+        long long* EvalA = Scratch;
+        long long* EvalB = EvalA + Third + 1;
+        long long* W1 = EvalB + Third + 1;
+        long long* W2 = W1 + Length;
+        long long* W3 = W2 + Length;
+        long long* Temp = W3 + Length;
+        long long* Next = Temp + Length;
+        long long* C0 = Answer;
+        long long* C4 = Answer + 4 * Third;
+
+        _multiply_recursive(C0, A, Third, B, Third, Scratch);
+        _multiply_recursive(C4, A + 2 * Third, A2Size, B + 2 * Third, B2Size,
+                            Scratch);
+        std::fill(Answer + 2 * Third, Answer + 4 * Third, 0);
+
+        long long* W[3] = {W1, W2, W3};
+        bool Square = (A == B);
+        for (int Point = 1; Point <= 3; ++Point) {
+            long long CarryA = 0;
+            long long CarryB = 0;
+            for (int i = 0; i < Third; ++i) {
+                long long TempA = A[i] + Point * A[Third + i] + CarryA;
+                if (i < A2Size) TempA += Point * Point * A[2 * Third + i];
+                CarryA = TempA / Max;
+                EvalA[i] = TempA % Max;
+                if (Square) continue;
+                long long TempB = B[i] + Point * B[Third + i] + CarryB;
+                if (i < B2Size) TempB += Point * Point * B[2 * Third + i];
+                CarryB = TempB / Max;
+                EvalB[i] = TempB % Max;
             }
+            EvalA[Third] = CarryA;
+            EvalB[Third] = CarryB;
+            _multiply_recursive(W[Point - 1], EvalA, Third + 1,
+                                Square ? EvalA : EvalB, Third + 1, Next);
         }
-        return (*this);
+
+        // G(1) = W(1) - C4, G(2) = W(2) - 16 * C4, G(3) = W(3) - 81 * C4
+        _sub_limbs(W1, W1, Length, C4, C4Size);
+        std::fill(Temp, Temp + Length, 0);
+        Temp[C4Size] = _mul_limbs_small(Temp, C4, C4Size, 16);
+        _sub_limbs(W2, W2, Length, Temp, Length);
+        Temp[C4Size] = _mul_limbs_small(Temp, C4, C4Size, 81);
+        _sub_limbs(W3, W3, Length, Temp, Length);
+
+        // C3 = (G(3) + 3 * G(1) - 3 * G(2) - G(0)) / 6
+        _mul_limbs_small(Temp, W1, Length, 3);
+        _add_limbs(W3, W3, Length, Temp, Length);
+        _mul_limbs_small(Temp, W2, Length, 3);
+        _add_limbs(Temp, Temp, Length, C0, 2 * Third);
+        _sub_limbs(W3, W3, Length, Temp, Length);
+        _div_limbs_small(W3, Length, 6);
+
+        // C2 = (G(2) + G(0) - 2 * G(1)) / 2 - 3 * C3
+        _add_limbs(W2, W2, Length, C0, 2 * Third);
+        _mul_limbs_small(Temp, W1, Length, 2);
+        _sub_limbs(W2, W2, Length, Temp, Length);
+        _div_limbs_small(W2, Length, 2);
+        _mul_limbs_small(Temp, W3, Length, 3);
+        _sub_limbs(W2, W2, Length, Temp, Length);
+
+        // C1 = G(1) - G(0) - C2 - C3
+        _sub_limbs(W1, W1, Length, C0, 2 * Third);
+        _sub_limbs(W1, W1, Length, W2, Length);
+        _sub_limbs(W1, W1, Length, W3, Length);
+
+        _accumulate(Answer + Third, ASize + BSize - Third, W1, Length);
+        _accumulate(Answer + 2 * Third, ASize + BSize - 2 * Third, W2, Length);
+        _accumulate(Answer + 3 * Third, ASize + BSize - 3 * Third, W3, Length);
     }
 
-    int2048& int2048::_simple_minus(const int2048& B)
+    int int2048::_multiply_scratch_size(int Size)
+    {
+        int Answer = 0;
+        while (Size >= KaratsubaThreshold) {
+            Answer += 4 * Size + 16;
+            Size = Size / 2 + 2;
+        }
+        return Answer;
+    }
+
+    long long int2048::_add_limbs(long long* Answer,
+                                  const long long* A, int ASize,
+                                  const long long* B, int BSize)
+    {
+        long long Carry = _add_n(Answer, A, B, BSize);
+        // The carry stops at the first element below Max - 1, the rest of
+        // A is only copied (nothing at all in place)
+        int i = BSize;
+        for (; Carry != 0 && i < ASize; ++i) {
+            Carry = (A[i] == Max - 1);
+            Answer[i] = Carry ? 0 : A[i] + 1;
+        }
+        if (Answer != A && i < ASize) {
+            std::memmove(Answer + i, A + i, sizeof(long long) * (ASize - i));
+        }
+        return Carry;
+    }
+
+    long long int2048::_sub_limbs(long long* Answer,
+                                  const long long* A, int ASize,
+                                  const long long* B, int BSize)
+    {
+        long long Carry = _sub_n(Answer, A, B, BSize);
+        int i = BSize;
+        for (; Carry != 0 && i < ASize; ++i) {
+            Carry = (A[i] == 0);
+            Answer[i] = Carry ? Max - 1 : A[i] - 1;
+        }
+        if (Answer != A && i < ASize) {
+            std::memmove(Answer + i, A + i, sizeof(long long) * (ASize - i));
+        }
+        return Carry;
+    }
+
+    long long int2048::_add_n(long long* Answer, const long long* A,
+                              const long long* B, int Size)
+    {
+#ifdef SJTU_INT2048_X86_SIMD
+        if (Size >= SimdThreshold) {
+            switch (get_simd_level()) {
+                case SimdAVX512: return _add_n_avx512(Answer, A, B, Size);
+                case SimdAVX2: return _add_n_avx2(Answer, A, B, Size);
+                default: break;
+            }
+        }
+#endif
+        return _add_n_scalar(Answer, A, B, Size);
+    }
+
+    long long int2048::_sub_n(long long* Answer, const long long* A,
+                              const long long* B, int Size)
+    {
+#ifdef SJTU_INT2048_X86_SIMD
+        if (Size >= SimdThreshold) {
+            switch (get_simd_level()) {
+                case SimdAVX512: return _sub_n_avx512(Answer, A, B, Size);
+                case SimdAVX2: return _sub_n_avx2(Answer, A, B, Size);
+                default: break;
+            }
+        }
+#endif
+        return _sub_n_scalar(Answer, A, B, Size);
+    }
+
+    int int2048::_compare_n(const long long* A, const long long* B, int Size)
+    {
+#ifdef SJTU_INT2048_X86_SIMD
+        if (Size >= SimdThreshold) {
+            switch (get_simd_level()) {
+                case SimdAVX512: return _compare_n_avx512(A, B, Size);
+                case SimdAVX2: return _compare_n_avx2(A, B, Size);
+                default: break;
+            }
+        }
+#endif
+        return _compare_n_scalar(A, B, Size);
+    }
+
+    long long int2048::_add_n_scalar(long long* Answer, const long long* A,
+                                     const long long* B, int Size)
     {
-        bool Carry = false;
-        for (int i = 0; i < B.Size; ++i) {
-            BigInt[i] = BigInt[i] - B.BigInt[i] - Carry;
-            if (BigInt[i] < 0) {
-                BigInt[i] += Max;
-                Carry = true;
+        long long Carry = 0;
+        for (int i = 0; i < Size; ++i) {
+            Answer[i] = A[i] + B[i] + Carry;
+            if (Answer[i] >= Max) {
+                Answer[i] -= Max;
+                Carry = 1;
                 continue;
             }
-            Carry = false;
+            Carry = 0;
         }
-        for (int i = B.Size; i < Size; ++i) {
-            BigInt[i] = BigInt[i] - Carry;
-            if (BigInt[i] < 0) {
-                BigInt[i] += Max;
-                Carry = true;
+        return Carry;
+    }
+
+    long long int2048::_sub_n_scalar(long long* Answer, const long long* A,
+                                     const long long* B, int Size)
+    {
+        long long Carry = 0;
+        for (int i = 0; i < Size; ++i) {
+            Answer[i] = A[i] - B[i] - Carry;
+            if (Answer[i] < 0) {
+                Answer[i] += Max;
+                Carry = 1;
                 continue;
             }
-            Carry = false;
+            Carry = 0;
         }
-        this->_resize();
-        return (*this);
+        return Carry;
+    }
+
+    int int2048::_compare_n_scalar(const long long* A, const long long* B,
+                                   int Size)
+    {
+        for (int i = Size - 1; i >= 0; --i) {
+            if (A[i] != B[i]) return (A[i] > B[i]) ? 1 : -1;
+        }
+        return 0;
+    }
+
+#ifdef SJTU_INT2048_X86_SIMD
+    /*
+     * Resolving the carries of a block of lanes: lane i generates a carry
+     * when its sum is at least Max (bit i of Generate), and passes on the
+     * carry it receives when its sum is Max - 1 (bit i of Propagate). Then
+     * the lanes receiving a carry are the bits of
+     *     In = (((Generate << 1) | CarryIn) + Propagate) ^ Propagate
+     * since a carry entering a run of propagating lanes ripples through the
+     * run in the integer addition, and the bit above the block is the carry
+     * out. A subtraction is the same with a borrow from a negative
+     * difference, passed on by a zero difference.
+     */
+    __attribute__((target("avx2")))
+    long long int2048::_add_n_avx2(long long* Answer, const long long* A,
+                                   const long long* B, int Size)
+    {
+        const __m256i MaxVector = _mm256_set1_epi64x(Max);
+        const __m256i Limit = _mm256_set1_epi64x(Max - 1);
+        const __m256i LaneBits = _mm256_set_epi64x(8, 4, 2, 1);
+        unsigned Carry = 0;
+        int i = 0;
+        for (; i + 4 <= Size; i += 4) {
+            __m256i Sum = _mm256_add_epi64(
+                _mm256_loadu_si256((const __m256i*)(A + i)),
+                _mm256_loadu_si256((const __m256i*)(B + i)));
+            unsigned Generate = _mm256_movemask_pd(
+                _mm256_castsi256_pd(_mm256_cmpgt_epi64(Sum, Limit)));
+            unsigned Propagate = _mm256_movemask_pd(
+                _mm256_castsi256_pd(_mm256_cmpeq_epi64(Sum, Limit)));
+            unsigned In = (((Generate << 1) | Carry) + Propagate) ^ Propagate;
+            Carry = In >> 4;
+            // -1 in the lanes receiving a carry
+            __m256i InLanes = _mm256_cmpeq_epi64(
+                _mm256_and_si256(_mm256_set1_epi64x(In), LaneBits), LaneBits);
+            Sum = _mm256_sub_epi64(Sum, InLanes);
+            Sum = _mm256_sub_epi64(Sum, _mm256_and_si256(
+                _mm256_cmpgt_epi64(Sum, Limit), MaxVector));
+            _mm256_storeu_si256((__m256i*)(Answer + i), Sum);
+        }
+        for (; i < Size; ++i) {
+            long long Sum = A[i] + B[i] + Carry;
+            Carry = (Sum >= Max);
+            Answer[i] = Carry ? Sum - Max : Sum;
+        }
+        return Carry;
+    }
+
+    __attribute__((target("avx2")))
+    long long int2048::_sub_n_avx2(long long* Answer, const long long* A,
+                                   const long long* B, int Size)
+    {
+        const __m256i MaxVector = _mm256_set1_epi64x(Max);
+        const __m256i Zero = _mm256_setzero_si256();
+        const __m256i LaneBits = _mm256_set_epi64x(8, 4, 2, 1);
+        unsigned Borrow = 0;
+        int i = 0;
+        for (; i + 4 <= Size; i += 4) {
+            __m256i Difference = _mm256_sub_epi64(
+                _mm256_loadu_si256((const __m256i*)(A + i)),
+                _mm256_loadu_si256((const __m256i*)(B + i)));
+            unsigned Generate = _mm256_movemask_pd(
+                _mm256_castsi256_pd(_mm256_cmpgt_epi64(Zero, Difference)));
+            unsigned Propagate = _mm256_movemask_pd(
+                _mm256_castsi256_pd(_mm256_cmpeq_epi64(Difference, Zero)));
+            unsigned In = (((Generate << 1) | Borrow) + Propagate) ^ Propagate;
+            Borrow = In >> 4;
+            __m256i InLanes = _mm256_cmpeq_epi64(
+                _mm256_and_si256(_mm256_set1_epi64x(In), LaneBits), LaneBits);
+            Difference = _mm256_add_epi64(Difference, InLanes);
+            Difference = _mm256_add_epi64(Difference, _mm256_and_si256(
+                _mm256_cmpgt_epi64(Zero, Difference), MaxVector));
+            _mm256_storeu_si256((__m256i*)(Answer + i), Difference);
+        }
+        for (; i < Size; ++i) {
+            long long Difference = A[i] - B[i] - Borrow;
+            Borrow = (Difference < 0);
+            Answer[i] = Borrow ? Difference + Max : Difference;
+        }
+        return Borrow;
+    }
+
+    __attribute__((target("avx2")))
+    int int2048::_compare_n_avx2(const long long* A, const long long* B, int Size)
+    {
+        int i = Size;
+        for (; i >= 4; i -= 4) {
+            unsigned Equal = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(
+                _mm256_loadu_si256((const __m256i*)(A + i - 4)),
+                _mm256_loadu_si256((const __m256i*)(B + i - 4)))));
+            if (Equal != 15) {
+                int Lane = i - 4 + 31 - __builtin_clz(~Equal & 15);
+                return (A[Lane] > B[Lane]) ? 1 : -1;
+            }
+        }
+        return _compare_n_scalar(A, B, i);
+    }
+
+    __attribute__((target("avx512f")))
+    long long int2048::_add_n_avx512(long long* Answer, const long long* A,
+                                     const long long* B, int Size)
+    {
+        const __m512i MaxVector = _mm512_set1_epi64(Max);
+        const __m512i Limit = _mm512_set1_epi64(Max - 1);
+        const __m512i One = _mm512_set1_epi64(1);
+        unsigned Carry = 0;
+        int i = 0;
+        for (; i + 8 <= Size; i += 8) {
+            __m512i Sum = _mm512_add_epi64(_mm512_loadu_si512(A + i),
+                                           _mm512_loadu_si512(B + i));
+            unsigned Generate = _mm512_cmpgt_epi64_mask(Sum, Limit);
+            unsigned Propagate = _mm512_cmpeq_epi64_mask(Sum, Limit);
+            unsigned In = (((Generate << 1) | Carry) + Propagate) ^ Propagate;
+            Carry = In >> 8;
+            Sum = _mm512_mask_add_epi64(Sum, (__mmask8)In, Sum, One);
+            Sum = _mm512_mask_sub_epi64(Sum, _mm512_cmpgt_epi64_mask(Sum, Limit),
+                                        Sum, MaxVector);
+            _mm512_storeu_si512(Answer + i, Sum);
+        }
+        for (; i < Size; ++i) {
+            long long Sum = A[i] + B[i] + Carry;
+            Carry = (Sum >= Max);
+            Answer[i] = Carry ? Sum - Max : Sum;
+        }
+        return Carry;
+    }
+
+    __attribute__((target("avx512f")))
+    long long int2048::_sub_n_avx512(long long* Answer, const long long* A,
+                                     const long long* B, int Size)
+    {
+        const __m512i MaxVector = _mm512_set1_epi64(Max);
+        const __m512i Zero = _mm512_setzero_si512();
+        const __m512i One = _mm512_set1_epi64(1);
+        unsigned Borrow = 0;
+        int i = 0;
+        for (; i + 8 <= Size; i += 8) {
+            __m512i Difference = _mm512_sub_epi64(_mm512_loadu_si512(A + i),
+                                                  _mm512_loadu_si512(B + i));
+            unsigned Generate = _mm512_cmplt_epi64_mask(Difference, Zero);
+            unsigned Propagate = _mm512_cmpeq_epi64_mask(Difference, Zero);
+            unsigned In = (((Generate << 1) | Borrow) + Propagate) ^ Propagate;
+            Borrow = In >> 8;
+            Difference = _mm512_mask_sub_epi64(Difference, (__mmask8)In,
+                                               Difference, One);
+            Difference = _mm512_mask_add_epi64(
+                Difference, _mm512_cmplt_epi64_mask(Difference, Zero),
+                Difference, MaxVector);
+            _mm512_storeu_si512(Answer + i, Difference);
+        }
+        for (; i < Size; ++i) {
+            long long Difference = A[i] - B[i] - Borrow;
+            Borrow = (Difference < 0);
+            Answer[i] = Borrow ? Difference + Max : Difference;
+        }
+        return Borrow;
     }
 
-    int2048& int2048::_reversed_simple_minus(const int2048& B)
+    __attribute__((target("avx512f")))
+    int int2048::_compare_n_avx512(const long long* A, const long long* B,
+                                   int Size)
     {
-        bool Carry = false;
-        BigInt.resize(B.Size, 0);
-        for (int i = 0; i < B.Size; ++i) {
-            BigInt[i] = B.BigInt[i] - BigInt[i] - Carry;
-            if (BigInt[i] < 0) {
-                BigInt[i] += Max;
-                Carry = true;
-                continue;
+        int i = Size;
+        for (; i >= 8; i -= 8) {
+            unsigned Different = _mm512_cmpneq_epi64_mask(
+                _mm512_loadu_si512(A + i - 8), _mm512_loadu_si512(B + i - 8));
+            if (Different != 0) {
+                int Lane = i - 8 + 31 - __builtin_clz(Different);
+                return (A[Lane] > B[Lane]) ? 1 : -1;
             }
-            Carry = false;
         }
-        Size = B.Size;
-        this->_resize();
-        return (*this);
+        return _compare_n_scalar(A, B, i);
     }
+#endif
 
-    int2048& int2048::_resize()
+    /// The best level of this CPU
+    simd_level _supported_simd_level()
     {
-        while (BigInt[Size - 1] == 0 && Size > 1) {
-            --Size;
-        }
-        return (*this);
+#ifdef SJTU_INT2048_X86_SIMD
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) return SimdAVX512;
+        if (__builtin_cpu_supports("avx2")) return SimdAVX2;
+#endif
+        return SimdNone;
     }
 
-    int2048 &int2048::add(const int2048& B)
+    simd_level& _current_simd_level()
     {
-        return (*this += B);
+        static simd_level Level = _supported_simd_level();
+        return Level;
     }
 
-    int2048 add(int2048 A, const int2048 &B)
+    simd_level get_simd_level()
     {
-        return (A += B);
+        return _current_simd_level();
     }
 
-    int2048 &int2048::minus(const int2048& B)
+    simd_level set_simd_level(simd_level Level)
     {
-        return (*this -= B);
+        _current_simd_level() = std::min(Level, _supported_simd_level());
+        return _current_simd_level();
     }
 
-    int2048 minus(int2048 A, const int2048& B)
+    long long int2048::_mul_limbs_small(long long* Answer,
+                                        const long long* A, int ASize,
+                                        long long Multiplier)
     {
-        return (A -= B);
+        long long Carry = 0;
+        for (int i = 0; i < ASize; ++i) {
+            long long Temp = A[i] * Multiplier + Carry;
+            Carry = Temp / Max;
+            Answer[i] = Temp % Max;
+        }
+        return Carry;
     }
 
-    int2048& int2048::operator=(const int2048&) = default;
+    long long int2048::_mod_limbs_small(const long long* A, int ASize,
+                                        long long Divisor)
+    {
+        long long Remainder = 0;
+        for (int i = ASize - 1; i >= 0; --i) {
+            Remainder = (Remainder * Max + A[i]) % Divisor;
+        }
+        return Remainder;
+    }
 
-    int2048& int2048::operator+=(const int2048& B)
+    long long int2048::_div_limbs_small(long long* A, int ASize,
+                                        long long Divisor)
     {
-        if ((IsPositive && B.IsPositive) || (!IsPositive && !B.IsPositive)) {
-            this->_simple_add(B);
-        } else {
-            if (AbsCompare(*this, B) == 1) {
-                this->_simple_minus(B);
-            } else {
-                this->_reversed_simple_minus(B);
-                IsPositive = !IsPositive;
-            }
+        long long Remainder = 0;
+        for (int i = ASize - 1; i >= 0; --i) {
+            long long Temp = Remainder * Max + A[i];
+            A[i] = Temp / Divisor;
+            Remainder = Temp % Divisor;
         }
-        return (*this);
+        return Remainder;
     }
 
-    int2048 operator+(int2048 A, const int2048& B)
+    void int2048::_accumulate(long long* Answer, int AnswerSize,
+                              const long long* A, int ASize)
     {
-        return (A += B);
+        long long Carry = 0;
+        int Length = std::min(AnswerSize, ASize);
+        for (int i = 0; i < Length; ++i) {
+            Answer[i] += A[i] + Carry;
+            if (Answer[i] >= Max) {
+                Answer[i] -= Max;
+                Carry = 1;
+                continue;
+            }
+            Carry = 0;
+        }
+        for (int i = Length; Carry != 0 && i < AnswerSize; ++i) {
+            Answer[i] += Carry;
+            if (Answer[i] >= Max) {
+                Answer[i] -= Max;
+                continue;
+            }
+            Carry = 0;
+        }
     }
 
-    int2048 &int2048::operator-=(const int2048& B)
+    int2048& int2048::_add_signed_limbs(const long long* B, int BSize,
+                                        bool BPositive)
     {
-        if ((!IsPositive && B.IsPositive) || (IsPositive && !B.IsPositive)) {
-            this->_simple_add(B);
-        } else {
-            if (AbsCompare(*this, B) == 1) {
-                this->_simple_minus(B);
+        while (BSize > 1 && B[BSize - 1] == 0) --BSize;
+        if (BSize == 1 && B[0] == 0) return (*this);
+        if (Size == 1 && BigInt[0] == 0) IsPositive = BPositive;
+        if (IsPositive == BPositive) {
+            int NewSize = std::max(Size, BSize);
+            BigInt.resize(NewSize + 1);
+            std::fill(BigInt.begin() + Size, BigInt.begin() + NewSize + 1, 0);
+            if (Size >= BSize) {
+                BigInt[NewSize] = _add_limbs(BigInt.data(), BigInt.data(), Size, B, BSize);
             } else {
-                this->_reversed_simple_minus(B);
+                BigInt[NewSize] = _add_limbs(BigInt.data(), B, BSize, BigInt.data(), Size);
+            }
+            Size = NewSize + 1;
+        } else {
+            int Compare = (Size != BSize) ? (Size > BSize ? 1 : -1) : 0;
+            for (int i = Size - 1; Compare == 0 && i >= 0; --i) {
+                if (BigInt[i] != B[i]) Compare = (BigInt[i] > B[i]) ? 1 : -1;
+            }
+            if (Compare == 1) {
+                _sub_limbs(BigInt.data(), BigInt.data(), Size, B, BSize);
+            } else if (Compare == -1) {
+                if ((int)BigInt.size() < BSize) BigInt.resize(BSize);
+                _sub_limbs(BigInt.data(), B, BSize, BigInt.data(), Size);
+                Size = BSize;
                 IsPositive = !IsPositive;
+            } else {
+                BigInt.assign(1, 0);
+                Size = 1;
             }
         }
+        _resize();
+        if (Size == 1 && BigInt[0] == 0) IsPositive = true;
         return (*this);
     }
 
-    int2048 operator-(int2048 A, const int2048& B)
+    int2048& int2048::_addmul(const int2048& A, const int2048& B, bool Negative)
     {
-        return (A -= B);
+        return _addmul(A.BigInt.data(), A.Size, B.BigInt.data(), B.Size,
+                       (A.IsPositive == B.IsPositive) != Negative);
     }
 
-    int2048 &int2048::operator*=(int2048 B)
+    int2048& int2048::_addmul(const long long* A, int ASize,
+                              const long long* B, int BSize, bool Positive)
     {
-        // For the IsPositive Flag
-        if ((!IsPositive && B.IsPositive) || (IsPositive && !B.IsPositive)) {
-            IsPositive = false;
-        } else {
-            IsPositive = true;
-        }
-
-        // For the Unsigned Multiplication
-        if (B == 0 || (*this) == 0) {
-            BigInt.clear();
-            BigInt.push_back(0);
-            Size = 1;
-            IsPositive = true;
+        if ((ASize == 1 && A[0] == 0) || (BSize == 1 && B[0] == 0)) {
             return (*this);
         }
-        std::vector<long long> A_Origin = BigInt;
-        BigInt.resize(Size + B.Size, 0);
-        long long Carry = 0;
-        long long Temp;
-        for (int A_Digit = 0; A_Digit < Size; ++A_Digit) {
-            Temp = A_Origin[A_Digit] * B.BigInt[0] + Carry;
-            Carry = Temp / Max;
-            BigInt[A_Digit] = Temp % Max;
+        bool Zero = (Size == 1 && BigInt[0] == 0);
+        bool Aliased = (A == BigInt.data() || B == BigInt.data());
+        if ((Zero || IsPositive == Positive) && !Aliased
+            && std::min(ASize, BSize) < KaratsubaThreshold) {
+            if (Zero) IsPositive = Positive;
+            int NewSize = std::max(Size, ASize + BSize) + 1;
+            BigInt.resize(NewSize);
+            std::fill(BigInt.begin() + Size, BigInt.begin() + NewSize, 0);
+            _addmul_limbs(BigInt.data(), NewSize, A, ASize, B, BSize);
+            Size = NewSize;
+            return _resize();
         }
-        if (Carry != 0) {
-            BigInt[Size] = Carry;
+
+        // Otherwise the product goes to a buffer kept between calls
+        static thread_local limb_vector Product(nullptr);
+        _multiply(Product, A, ASize, B, BSize);
+        return _add_signed_limbs(Product.data(), ASize + BSize, Positive);
+    }
+
+    void int2048::_linear_combination(int2048& Answer,
+                                      const int2048* const* Values,
+                                      const bool* Negative, int Count)
+    {
+        struct source
+        {
+            const int2048* Value;
+            int Size;
+            bool Negative;
+        };
+        source Stack[16];
+        std::vector<source> Heap;
+        source* Sources = Stack;
+        if (Count > 16) {
+            Heap.resize(Count);
+            Sources = Heap.data();
         }
-        BigInt[Size] = Carry;
-        for (int B_Digit = 1; B_Digit < B.Size; ++B_Digit) {
-            Carry = 0;
-            for (int A_Digit = 0; A_Digit < Size; ++A_Digit) {
-                Temp = A_Origin[A_Digit] * B.BigInt[B_Digit] + Carry
-                     + BigInt[A_Digit + B_Digit];
-                Carry = Temp / Max;
-                BigInt[A_Digit + B_Digit] = Temp % Max;
+        int Length = 1;
+        for (int i = 0; i < Count; ++i) {
+            Sources[i].Value = Values[i];
+            Sources[i].Size = Values[i]->Size;
+            Sources[i].Negative = (Negative[i] == Values[i]->IsPositive);
+            Length = std::max(Length, Values[i]->Size);
+        }
+
+        // Answer[j] is written after every term has read its element j, so
+        // Answer itself may be a term (only its first Size elements count)
+        Answer.BigInt.resize(Length + 1);
+        long long* Result = Answer.BigInt.data();
+        long long Carry = 0;
+        for (int j = 0; j < Length; ++j) {
+            long long Sum = Carry;
+            for (int i = 0; i < Count; ++i) {
+                if (j >= Sources[i].Size) continue;
+                if (Sources[i].Negative) {
+                    Sum -= Sources[i].Value->BigInt[j];
+                } else {
+                    Sum += Sources[i].Value->BigInt[j];
+                }
+            }
+            Carry = Sum / Max;
+            Sum %= Max;
+            if (Sum < 0) {
+                Sum += Max;
+                --Carry;
             }
-            BigInt[Size + B_Digit] = Carry;
+            Result[j] = Sum;
         }
-        if (Carry != 0) {
-            Size = Size + B.Size;
-        } else {
-            Size = Size + B.Size - 1;
+
+        // A negative carry means Carry * Max^Length + Result < 0, whose
+        // absolute value is (-Carry) * Max^Length - Result
+        Answer.IsPositive = (Carry >= 0);
+        if (Carry < 0) {
+            long long Borrow = 0;
+            for (int j = 0; j < Length; ++j) {
+                long long Temp = -Result[j] - Borrow;
+                Borrow = 0;
+                if (Temp < 0) {
+                    Temp += Max;
+                    Borrow = 1;
+                }
+                Result[j] = Temp;
+            }
+            Carry = -Carry - Borrow;
         }
-        return (*this);
+        Result[Length] = Carry;
+        Answer.Size = Length + 1;
+        Answer._resize();
+        if (Answer.Size == 1 && Result[0] == 0) Answer.IsPositive = true;
     }
 
-    int2048 operator*(int2048 A, const int2048& B)
+    void int2048::_addmul_limbs(long long* Answer, int AnswerSize,
+                                const long long* A, int ASize,
+                                const long long* B, int BSize)
     {
-        // For the IsPositive Flag
-        if ((!A.IsPositive && B.IsPositive) || (A.IsPositive && !B.IsPositive)) {
-            A.IsPositive = false;
-        } else {
-            A.IsPositive = true;
+        for (int B_Digit = 0; B_Digit < BSize; ++B_Digit) {
+            long long Carry = 0;
+            for (int A_Digit = 0; A_Digit < ASize; ++A_Digit) {
+                long long Temp = A[A_Digit] * B[B_Digit] + Carry
+                               + Answer[A_Digit + B_Digit];
+                Carry = Temp / Max;
+                Answer[A_Digit + B_Digit] = Temp % Max;
+            }
+            for (int i = ASize + B_Digit; Carry != 0 && i < AnswerSize; ++i) {
+                long long Temp = Answer[i] + Carry;
+                Carry = Temp / Max;
+                Answer[i] = Temp % Max;
+            }
         }
+    }
 
-        // For the Unsigned Multiplication
-        if (A == 0 || B == 0) {
-            A.BigInt.clear();
-            A.BigInt.push_back(0);
-            A.Size = 1;
-            A.IsPositive = true;
-            return A;
-        }
-        std::vector<long long> A_Origin = A.BigInt;
-        A.BigInt.resize(A.Size + B.Size, 0);
-        long long Carry = 0;
+    void int2048::_schoolbook_multiply(long long* Answer,
+                                       const long long* A, int ASize,
+                                       const long long* B, int BSize)
+    {
+        long long Carry;
         long long Temp;
-        for (int A_Digit = 0; A_Digit < A.Size; ++A_Digit) {
-            Temp = A_Origin[A_Digit] * B.BigInt[0] + Carry;
-            Carry = Temp / Max;
-            A.BigInt[A_Digit] = Temp % Max;
-        }
-        A.BigInt[A.Size] = Carry;
-        for (int B_Digit = 1; B_Digit < B.Size; ++B_Digit) {
+        for (int B_Digit = 0; B_Digit < BSize; ++B_Digit) {
             Carry = 0;
-            for (int A_Digit = 0; A_Digit < A.Size; ++A_Digit) {
-                Temp = A_Origin[A_Digit] * B.BigInt[B_Digit] + Carry
-                     + A.BigInt[A_Digit + B_Digit];
+            for (int A_Digit = 0; A_Digit < ASize; ++A_Digit) {
+                Temp = A[A_Digit] * B[B_Digit] + Carry
+                     + Answer[A_Digit + B_Digit];
                 Carry = Temp / Max;
-                A.BigInt[A_Digit + B_Digit] = Temp % Max;
+                Answer[A_Digit + B_Digit] = Temp % Max;
             }
-            A.BigInt[A.Size + B_Digit] = Carry;
+            Answer[ASize + B_Digit] = Carry;
         }
-        if (Carry != 0) {
-            A.Size = A.Size + B.Size;
-        } else {
-            A.Size = A.Size + B.Size - 1;
-        }
-        return A;
     }
 
-    int2048& int2048::operator/=(int2048 B)
+    void int2048::_schoolbook_square(long long* Answer,
+                                     const long long* A, int Size)
     {
-        // For the IsPositive Flag
-        if ((!IsPositive && B.IsPositive) || (IsPositive && !B.IsPositive)) {
-            IsPositive = false;
-        } else {
-            IsPositive = true;
+        for (int i = 0; i < Size; ++i) {
+            long long Carry = 0;
+            for (int j = i + 1; j < Size; ++j) {
+                long long Temp = A[i] * A[j] + Carry + Answer[i + j];
+                Carry = Temp / Max;
+                Answer[i + j] = Temp % Max;
+            }
+            Answer[i + Size] = Carry;
         }
 
-        // For the Unsigned Division
-        if (Size < B.Size) {
-            BigInt.clear();
-            BigInt.push_back(0);
-            Size = 1;
-            IsPositive = true;
-            return (*this);
+        // Answer = 2 * Answer + the squares A[i]^2 at 2 * i
+        long long Carry = 0;
+        for (int i = 0; i < Size; ++i) {
+            long long Diagonal = A[i] * A[i];
+            long long Temp = 2 * Answer[2 * i] + Diagonal % Max + Carry;
+            Answer[2 * i] = Temp % Max;
+            Temp = 2 * Answer[2 * i + 1] + Diagonal / Max + Temp / Max;
+            Answer[2 * i + 1] = Temp % Max;
+            Carry = Temp / Max;
         }
-        std::vector<long long> TempA = BigInt;
-        BigInt.clear();
-        BigInt.resize(Size - B.Size + 1, 0);
-        int ASize = Size;
-        std::vector<long long> Temp = std::vector<long long>(B.Size + 1);
-        Temp.resize(B.Size + 1, 0);
-        for (int i = Size - B.Size; i >= 0; --i) {
-            long long L = 0;
-            long long R = Max - 1;
-
-            // R * B
-            int TempSize;
-            Temp = B._single_multiply(Temp, R);
-            if (Temp[B.Size] == 0) TempSize = B.Size;
-            else TempSize = B.Size + 1;
-            if (!AbsCompareLess(TempA, i, ASize, Temp, TempSize)) {
-                bool Carry = false;
-                for (int j = 0; j < TempSize; ++j) {
-                    TempA[i + j] = TempA[i + j] - Temp[j] - Carry;
-                    if (TempA[i + j] < 0) {
-                        Carry = true;
-                        TempA[i + j] += Max;
-                        continue;
-                    }
-                    Carry = false;
-                }
-                if (Carry) --TempA[ASize - 1];
-                BigInt[i] += R;
-                while (TempA[ASize - 1] == 0 && ASize > 1) {
-                    --ASize;
-                }
-                continue;
-            }
-            // Binary Search
-            while (R - L > 1) {
-                Temp = B._single_multiply(Temp, (L + R) / 2);
-                if (Temp[B.Size] == 0) TempSize = B.Size;
-                else TempSize = B.Size + 1;
-                if (!AbsCompareLess(TempA, i, ASize, Temp, TempSize)) {
-                    L = (L + R) / 2;
-                } else {
-                    R = (L + R) / 2;
-                }
+    }
+
+    void int2048::_ntt_multiply(long long* Answer,
+                                const long long* A, int ASize,
+                                const long long* B, int BSize)
+    {
+        if (ASize + BSize - 1 > NTTMaxLength) {
+            // Too long for the primes, split the longer one into two halves
+            if (ASize < BSize) {
+                std::swap(A, B);
+                std::swap(ASize, BSize);
             }
-            Temp = B._single_multiply(Temp, L);
-            if (Temp[B.Size] == 0) TempSize = B.Size;
-            else TempSize = B.Size + 1;
-            bool Carry = false;
-            for (int j = 0; j < TempSize; ++j) {
-                TempA[i + j] = TempA[i + j] - Temp[j] - Carry;
-                if (TempA[i + j] < 0) {
-                    Carry = true;
-                    TempA[i + j] += Max;
+            int Half = ASize / 2;
+            std::vector<long long> High(ASize - Half + BSize, 0);
+            _parallel_invoke(true,
+                [&] { _ntt_multiply(Answer, A, Half, B, BSize); },
+                [&] { _ntt_multiply(High.data(), A + Half, ASize - Half, B, BSize); });
+            long long Carry = 0;
+            for (int i = 0; i < ASize - Half + BSize; ++i) {
+                Answer[Half + i] += High[i] + Carry;
+                if (Answer[Half + i] >= Max) {
+                    Answer[Half + i] -= Max;
+                    Carry = 1;
                     continue;
                 }
-                Carry = false;
-            }
-            if (Carry) --TempA[ASize - 1];
-            BigInt[i] += L;
-            while (TempA[ASize - 1] == 0 && ASize > 1) {
-                --ASize;
+                Carry = 0;
             }
+            return;
         }
-        Size = Size - B.Size + 1;
-        _resize();
-        return (*this);
+
+        int Length = 1;
+        while (Length < ASize + BSize - 1) Length <<= 1;
+        std::vector<unsigned> R1, R2, R3;
+        _parallel_invoke(Length >= ParallelGrain,
+            [&] { R1 = _ntt_convolve<NTTMod1>(A, ASize, B, BSize, Length); },
+            [&] { R2 = _ntt_convolve<NTTMod2>(A, ASize, B, BSize, Length); },
+            [&] { R3 = _ntt_convolve<NTTMod3>(A, ASize, B, BSize, Length); });
+
+        // CRT (Garner): X = R1 + Mod1 * (K1 + Mod2 * K2)
+        static const unsigned long long Inverse1 =
+            _power_mod<NTTMod2>(NTTMod1, NTTMod2 - 2);
+        static const unsigned long long Inverse12 =
+            _power_mod<NTTMod3>(1ULL * NTTMod1 * NTTMod2 % NTTMod3, NTTMod3 - 2);
+        unsigned long long Carry = 0;
+        for (int i = 0; i < ASize + BSize - 1; ++i) {
+            unsigned long long K1 = (R2[i] + NTTMod2 - R1[i] % NTTMod2)
+                                  * Inverse1 % NTTMod2;
+            unsigned long long K2 = (R3[i] + NTTMod3
+                                  - (R1[i] + NTTMod1 % NTTMod3 * K1) % NTTMod3)
+                                  * Inverse12 % NTTMod3;
+            unsigned long long T = K1 + NTTMod2 * K2; // less than Mod2 * Mod3
+            // Split T by Max so that no intermediate overflows 64 bits
+            unsigned long long Low = R1[i] + NTTMod1 * (T % Max) + Carry;
+            Answer[i] = Low % Max;
+            Carry = Low / Max + NTTMod1 * (T / Max);
+        }
+        Answer[ASize + BSize - 1] = Carry;
     }
 
-    int2048 operator/(int2048 A, const int2048& B)
+    template <unsigned Mod>
+    std::vector<unsigned> int2048::_ntt_convolve(const long long* A, int ASize,
+                                                 const long long* B, int BSize,
+                                                 int Length)
     {
-        // For the IsPositive Flag
-        if ((!A.IsPositive && B.IsPositive) || (A.IsPositive && !B.IsPositive)) {
-            A.IsPositive = false;
-        } else {
-            A.IsPositive = true;
-        }
-
-        // For the Unsigned Division
-        if (A.Size < B.Size) {
-            A.BigInt.clear();
-            A.BigInt.push_back(0);
-            A.Size = 1;
-            A.IsPositive = true;
-            return A;
-        }
-        std::vector<long long> TempA = A.BigInt;
-        A.BigInt.clear();
-        A.BigInt.resize(A.Size - B.Size + 1, 0);
-        int ASize = A.Size;
-        std::vector<long long> Temp = std::vector<long long>(B.Size + 1);
-        Temp.resize(B.Size + 1, 0);
-        for (int i = A.Size - B.Size; i >= 0; --i) {
-            long long L = 0;
-            long long R = Max - 1;
-
-            // R * B
-            int TempSize;
-            Temp = B._single_multiply(Temp, R);
-            if (Temp[B.Size] == 0) TempSize = B.Size;
-            else TempSize = B.Size + 1;
-            if (!AbsCompareLess(TempA, i, ASize, Temp, TempSize)) {
-                bool Carry = false;
-                for (int j = 0; j < TempSize; ++j) {
-                    TempA[i + j] = TempA[i + j] - Temp[j] - Carry;
-                    if (TempA[i + j] < 0) {
-                        Carry = true;
-                        TempA[i + j] += Max;
-                        continue;
-                    }
-                    Carry = false;
-                }
-                if (Carry) --TempA[ASize - 1];
-                A.BigInt[i] += R;
-                while (TempA[ASize - 1] == 0 && ASize > 1) {
-                    --ASize;
-                }
-                continue;
+        // A square transforms its operand once
+        bool Square = (A == B && ASize == BSize);
+        std::vector<unsigned> FA(Length, 0);
+        std::vector<unsigned> FB;
+        for (int i = 0; i < ASize; ++i) FA[i] = A[i] % Mod;
+        if (!Square) {
+            FB.assign(Length, 0);
+            for (int i = 0; i < BSize; ++i) FB[i] = B[i] % Mod;
+        }
+        _parallel_invoke(Length >= ParallelGrain,
+            [&] { _ntt<Mod>(FA, false); },
+            [&] { if (!Square) _ntt<Mod>(FB, false); });
+        const std::vector<unsigned>& Other = Square ? FA : FB;
+        _parallel_for(0, Length, ParallelGrain, [&](long long First, long long Last) {
+            for (long long i = First; i < Last; ++i) {
+                FA[i] = 1ULL * FA[i] * Other[i] % Mod;
             }
-            // Binary Search
-            while (R - L > 1) {
-                Temp = B._single_multiply(Temp, (L + R) / 2);
-                if (Temp[B.Size] == 0) TempSize = B.Size;
-                else TempSize = B.Size + 1;
-                if (!AbsCompareLess(TempA, i, ASize, Temp, TempSize)) {
-                    L = (L + R) / 2;
-                } else {
-                    R = (L + R) / 2;
+        });
+        _ntt<Mod>(FA, true);
+        return FA;
+    }
+
+    template <unsigned Mod>
+    void int2048::_ntt(std::vector<unsigned>& Data, bool Inverse)
+    {
+        int Length = Data.size();
+        for (int i = 1, j = 0; i < Length; ++i) {
+            int Bit = Length >> 1;
+            for (; j & Bit; Bit >>= 1) j ^= Bit;
+            j ^= Bit;
+            if (i < j) std::swap(Data[i], Data[j]);
+        }
+        std::vector<unsigned> Omega(Length / 2 + 1);
+        for (int Half = 1; Half < Length; Half <<= 1) {
+            unsigned long long W = _power_mod<Mod>(NTTRoot, (Mod - 1) / (Half * 2));
+            if (Inverse) W = _power_mod<Mod>(W, Mod - 2);
+            Omega[0] = 1;
+            for (int k = 1; k < Half; ++k) Omega[k] = Omega[k - 1] * W % Mod;
+            // Butterfly t of the layer is element k = t % Half of the block
+            // from i = t / Half * 2 * Half, any range of them is independent
+            _parallel_for(0, Length / 2, ParallelGrain / 2,
+                          [&](long long First, long long Last) {
+                long long k = First % Half;
+                for (long long i = First / Half * Half * 2; First < Last; i += Half * 2) {
+                    for (; k < Half && First < Last; ++k, ++First) {
+                        unsigned X = Data[i + k];
+                        unsigned Y = 1ULL * Data[i + k + Half] * Omega[k] % Mod;
+                        Data[i + k] = (X + Y >= Mod) ? (X + Y - Mod) : (X + Y);
+                        Data[i + k + Half] = (X >= Y) ? (X - Y) : (X + Mod - Y);
+                    }
+                    k = 0;
                 }
-            }
-            Temp = B._single_multiply(Temp, L);
-            if (Temp[B.Size] == 0) TempSize = B.Size;
-            else TempSize = B.Size + 1;
-            bool Carry = false;
-            for (int j = 0; j < TempSize; ++j) {
-                TempA[i + j] = TempA[i + j] - Temp[j] - Carry;
-                if (TempA[i + j] < 0) {
-                    Carry = true;
-                    TempA[i + j] += Max;
-                    continue;
+            });
+        }
+        if (Inverse) {
+            unsigned long long LengthInverse = _power_mod<Mod>(Length, Mod - 2);
+            _parallel_for(0, Length, ParallelGrain, [&](long long First, long long Last) {
+                for (long long i = First; i < Last; ++i) {
+                    Data[i] = Data[i] * LengthInverse % Mod;
                 }
-                Carry = false;
-            }
-            if (Carry) --TempA[ASize - 1];
-            A.BigInt[i] += L;
-            while (TempA[ASize - 1] == 0 && ASize > 1) {
-                --ASize;
-            }
+            });
         }
-        A.Size = A.Size - B.Size + 1;
-        A._resize();
-        return A;
     }
 
-    std::istream& operator>>(std::istream& InStream, int2048& Object)
+    template <unsigned Mod>
+    unsigned int2048::_power_mod(unsigned long long Base,
+                                 unsigned long long Exponent)
     {
-        std::string Temp;
-        InStream >> Temp;
-        Object.read(Temp);
-        return InStream;
+        unsigned long long Answer = 1;
+        Base %= Mod;
+        while (Exponent != 0) {
+            if (Exponent & 1) Answer = Answer * Base % Mod;
+            Base = Base * Base % Mod;
+            Exponent >>= 1;
+        }
+        return Answer;
     }
 
-    std::ostream& operator<<(std::ostream& OutStream, const int2048& Object)
+    template <int Terms, int Products>
+    lazy_sum<Terms, Products>::operator int2048() const
     {
-        if (!Object.IsPositive) OutStream << "-";
-        OutStream << Object.BigInt[Object.Size - 1];
-        for (int i = Object.Size - 2; i >= 0; --i) {
-            long long Temp = Object.BigInt[i];
-            for (int j = MaxDigit - 1; j >= 0; --j) {
-                OutStream << (Temp / Power[j]);
-                Temp = Temp % Power[j];
-            }
-        }
-        return OutStream;
+        int2048 Answer;
+        evaluate(Answer, false, false);
+        return Answer;
     }
 
-    bool operator==(const int2048& A, const int2048& B)
+    template <int Terms, int Products>
+    void lazy_sum<Terms, Products>::evaluate(int2048& Answer, bool Accumulate,
+                                             bool Negate) const
     {
-        if ((A.IsPositive && B.IsPositive) || (!A.IsPositive && !B.IsPositive)) {
-            if (AbsCompare(A, B) == 0) return true;
+        const int2048* AllValues[Terms + 1];
+        bool AllNegative[Terms + 1];
+        int Count = 0;
+        if (Accumulate) {
+            AllValues[Count] = &Answer;
+            AllNegative[Count++] = false;
         }
-        return false;
+        for (int i = 0; i < Terms; ++i) {
+            AllValues[Count] = Values[i];
+            AllNegative[Count++] = (Negative[i] != Negate);
+        }
+
+        // A product reading Answer needs its value before the sum changes it
+        bool Aliased = false;
+        for (int i = 0; i < Products; ++i) {
+            Aliased = Aliased || Factors[i][0] == &Answer || Factors[i][1] == &Answer;
+        }
+        int2048 Temp;
+        int2048& Target = Aliased ? Temp : Answer;
+        if (Count != 1 || AllValues[0] != &Target || AllNegative[0]) {
+            int2048::_linear_combination(Target, AllValues, AllNegative, Count);
+        }
+        for (int i = 0; i < Products; ++i) {
+            Target._addmul(*Factors[i][0], *Factors[i][1],
+                           ProductNegative[i] != Negate);
+        }
+        if (Aliased) Answer = std::move(Temp);
     }
 
-    bool operator!=(const int2048& A, const int2048& B)
+    lazy_sum<1, 0> lazy(const int2048& A)
     {
-        return (!(A == B));
+        lazy_sum<1, 0> Answer;
+        Answer.Values[0] = &A;
+        Answer.Negative[0] = false;
+        return Answer;
     }
 
-    bool operator<(const int2048& A, const int2048& B)
+    template <int T1, int P1, int T2, int P2>
+    lazy_sum<T1 + T2, P1 + P2> operator+(const lazy_sum<T1, P1>& A,
+                                         const lazy_sum<T2, P2>& B)
     {
-        if (A.IsPositive && !B.IsPositive) return false;
-        if (!A.IsPositive && B.IsPositive) return true;
-        if (A.IsPositive) {
-            if (AbsCompare(A, B) == -1) return true;
-            else return false;
-        } else {
-            if (AbsCompare(A, B) == 1) return true;
-            else return false;
+        lazy_sum<T1 + T2, P1 + P2> Answer;
+        for (int i = 0; i < T1; ++i) {
+            Answer.Values[i] = A.Values[i];
+            Answer.Negative[i] = A.Negative[i];
         }
+        for (int i = 0; i < T2; ++i) {
+            Answer.Values[T1 + i] = B.Values[i];
+            Answer.Negative[T1 + i] = B.Negative[i];
+        }
+        for (int i = 0; i < P1; ++i) {
+            Answer.Factors[i][0] = A.Factors[i][0];
+            Answer.Factors[i][1] = A.Factors[i][1];
+            Answer.ProductNegative[i] = A.ProductNegative[i];
+        }
+        for (int i = 0; i < P2; ++i) {
+            Answer.Factors[P1 + i][0] = B.Factors[i][0];
+            Answer.Factors[P1 + i][1] = B.Factors[i][1];
+            Answer.ProductNegative[P1 + i] = B.ProductNegative[i];
+        }
+        return Answer;
     }
 
-    bool operator>(const int2048& A, const int2048& B)
+    template <int T1, int P1, int T2, int P2>
+    lazy_sum<T1 + T2, P1 + P2> operator-(const lazy_sum<T1, P1>& A,
+                                         const lazy_sum<T2, P2>& B)
     {
-        if (A.IsPositive && !B.IsPositive) return true;
-        if (!A.IsPositive && B.IsPositive) return false;
-        if (A.IsPositive) {
-            if (AbsCompare(A, B) == 1) return true;
-            else return false;
-        } else {
-            if (AbsCompare(A, B) == -1) return true;
-            else return false;
-        }
+        return A + (-B);
     }
 
-    bool operator<=(const int2048& A, const int2048& B)
+    template <int T, int P>
+    lazy_sum<T, P> operator-(const lazy_sum<T, P>& A)
     {
-        if (A.IsPositive && !B.IsPositive) return false;
-        if (!A.IsPositive && B.IsPositive) return true;
-        if (A.IsPositive) {
-            if (AbsCompare(A, B) == 1) return false;
-            else return true;
-        } else {
-            if (AbsCompare(A, B) == -1) return false;
-            else return true;
-        }
+        lazy_sum<T, P> Answer = A;
+        for (int i = 0; i < T; ++i) Answer.Negative[i] = !A.Negative[i];
+        for (int i = 0; i < P; ++i) Answer.ProductNegative[i] = !A.ProductNegative[i];
+        return Answer;
     }
 
-    bool operator>=(const int2048& A, const int2048& B)
+    template <int T, int P, class Value, enable_if_int2048<Value>>
+    lazy_sum<T + 1, P> operator+(const lazy_sum<T, P>& A, Value&& B)
     {
-        if (A.IsPositive && !B.IsPositive) return true;
-        if (!A.IsPositive && B.IsPositive) return false;
-        if (A.IsPositive) {
-            if (AbsCompare(A, B) == -1) return false;
-            else return true;
-        } else {
-            if (AbsCompare(A, B) == 1) return false;
-            else return true;
-        }
+        return A + lazy(B);
     }
 
-    /**
-     * @brief To Compare the ABS of A and B
-     * @param A
-     * @param B
-     * @return If |A| = |B|, return 0.
-     * If |A| > |B|, return 1.
-     * If |A| < |B|, return -1.
-     */
-    int AbsCompare(const int2048& A, const int2048& B)
+    template <int T, int P, class Value, enable_if_int2048<Value>>
+    lazy_sum<T + 1, P> operator+(Value&& A, const lazy_sum<T, P>& B)
     {
-        if (A.Size != B.Size) {
-            if (A.Size > B.Size) return 1;
-            else return -1;
-        }
-        for (int i = A.Size - 1; i >= 0; --i) {
-            if (A.BigInt[i] != B.BigInt[i]) {
-                if (A.BigInt[i] > B.BigInt[i]) return 1;
-                else return -1;
-            }
-        }
-        return 0;
+        return lazy(A) + B;
     }
 
-    /**
-     * @brief To Multiply a "long long int" and a "BigInt"
-     * @param Object
-     * @param A the long long int
-     * @return the answer vector
-     */
-    std::vector<long long>& int2048::_single_multiply(std::vector<long long>& Answer,
-                                                      long long A) const
+    template <int T, int P, class Value, enable_if_int2048<Value>>
+    lazy_sum<T + 1, P> operator-(const lazy_sum<T, P>& A, Value&& B)
     {
-        long long Carry = 0;
-        for (int i = 0; i < Size; ++i) {
-            Answer[i] = A * BigInt[i] + Carry;
-            Carry = Answer[i] / Max;
-            Answer[i] = Answer[i] % Max;
-        }
-        Answer[Size] = Carry;
+        return A - lazy(B);
+    }
+
+    template <int T, int P, class Value, enable_if_int2048<Value>>
+    lazy_sum<T + 1, P> operator-(Value&& A, const lazy_sum<T, P>& B)
+    {
+        return lazy(A) - B;
+    }
+
+    lazy_sum<0, 1> operator*(const lazy_sum<1, 0>& A, const lazy_sum<1, 0>& B)
+    {
+        lazy_sum<0, 1> Answer;
+        Answer.Factors[0][0] = A.Values[0];
+        Answer.Factors[0][1] = B.Values[0];
+        Answer.ProductNegative[0] = (A.Negative[0] != B.Negative[0]);
         return Answer;
     }
 
+    template <class Value, enable_if_int2048<Value>>
+    lazy_sum<0, 1> operator*(const lazy_sum<1, 0>& A, Value&& B)
+    {
+        return A * lazy(B);
+    }
+
+    template <class Value, enable_if_int2048<Value>>
+    lazy_sum<0, 1> operator*(Value&& A, const lazy_sum<1, 0>& B)
+    {
+        return lazy(A) * B;
+    }
+
+    template <int T, int P>
+    int2048& operator+=(int2048& A, const lazy_sum<T, P>& B)
+    {
+        B.evaluate(A, true, false);
+        return A;
+    }
+
+    template <int T, int P>
+    int2048& operator-=(int2048& A, const lazy_sum<T, P>& B)
+    {
+        B.evaluate(A, true, true);
+        return A;
+    }
+
     bool AbsCompareLess(const std::vector<long long>& A, int Start, int End,
                         const std::vector<long long>& B, int BLength)
     {
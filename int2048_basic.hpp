@@ -82,9 +82,18 @@ namespace sjtu
         int2048& operator*=(int2048);
         friend int2048 operator*(int2048, const int2048&);
 
+        /// Division truncates toward zero and the remainder takes the sign
+        /// of the dividend (as built-in integers do), so that
+        /// A == A / B * B + A % B
         int2048& operator/=(int2048);
         friend int2048 operator/(int2048, const int2048&);
 
+        int2048& operator%=(const int2048&);
+        friend int2048 operator%(int2048, const int2048&);
+
+        /// Return the quotient and the remainder of one division
+        friend std::pair<int2048, int2048> divmod(const int2048&, const int2048&);
+
         friend std::istream& operator>>(std::istream &, int2048&);
         friend std::ostream& operator<<(std::ostream &, const int2048&);
 
@@ -853,97 +862,67 @@ sjtu::int2048 sjtu::operator*(sjtu::int2048 A, const sjtu::int2048& B)
 
 sjtu::int2048& sjtu::int2048::operator/=(sjtu::int2048 B)
 {
-    // For the IsPositive Flag
-    if ((!IsPositive && B.IsPositive) || (IsPositive && !B.IsPositive)) {
-        IsPositive = false;
-    } else {
-        IsPositive = true;
-    }
-
-    // For the Unsigned Division
-    if (Length < B.Length) {
-        BigInt = "0";
-        IsPositive = true;
-        Length = 1;
-        return (*this);
-    }
-    std::string TempA;
-    TempA.resize(Length - B.Length + 1, '0');
-    int ALength = Length;
-    for (int i = Length - B.Length; i >= 0; --i) {
-        while (!sjtu::AbsCompareLess(BigInt, i, Length, B.BigInt, B.Length)) {
-            bool Carry = false;
-            for (int j = 0; j < B.Length; ++j) {
-                BigInt[i + j] = BigInt[i + j] - B.BigInt[j] - Carry + 48;
-                if (BigInt[i + j] < 48) {
-                    Carry = true;
-                    BigInt[i + j] += 10;
-                    continue;
-                }
-                Carry = false;
-            }
-            if (Carry) --BigInt[Length - 1];
-            TempA[i] += 1;
-            while (BigInt[Length - 1] == '0' && Length > 1) {
-                --Length;
-            }
-        }
-    }
-    BigInt = TempA;
-    Length = ALength - B.Length + 1;
-    while (BigInt[Length - 1] == '0' && Length > 1) {
-        --Length;
-    }
-    return (*this);
+    return (*this = divmod(*this, B).first);
 }
 
 sjtu::int2048 sjtu::operator/(sjtu::int2048 A, const sjtu::int2048& B)
 {
-    // For the IsPositive Flag
-    if ((!A.IsPositive && B.IsPositive) || (A.IsPositive && !B.IsPositive)) {
-        A.IsPositive = false;
-    } else {
-        A.IsPositive = true;
-    }
+    return (A /= B);
+}
 
-    // For the Unsigned Division
-    if (A.Length < B.Length) {
-        A.BigInt = "0";
-        A.IsPositive = true;
-        A.Length = 1;
-        return A;
-    }
-    std::string TempA;
-    TempA.resize(A.Length - B.Length + 1, '0');
-    int ALength = A.Length;
+sjtu::int2048& sjtu::int2048::operator%=(const sjtu::int2048& B)
+{
+    return (*this = divmod(*this, B).second);
+}
+
+sjtu::int2048 sjtu::operator%(sjtu::int2048 A, const sjtu::int2048& B)
+{
+    return (A %= B);
+}
+
+std::pair<sjtu::int2048, sjtu::int2048> sjtu::divmod(const sjtu::int2048& A,
+                                                     const sjtu::int2048& B)
+{
+    std::pair<int2048, int2048> Answer(0, A);
+    int2048& Quotient = Answer.first;
+    int2048& Remainder = Answer.second;
+    if (A.Length < B.Length) return Answer;
+
+    // Subtract B from the remainder digit by digit, from the highest place
+    Quotient.BigInt.assign(A.Length - B.Length + 1, '0');
+    Quotient.Length = A.Length - B.Length + 1;
     for (int i = A.Length - B.Length; i >= 0; --i) {
-        while (!sjtu::AbsCompareLess(A.BigInt, i, A.Length, B.BigInt, B.Length)) {
+        while (!sjtu::AbsCompareLess(Remainder.BigInt, i, Remainder.Length,
+                                     B.BigInt, B.Length)) {
             bool Carry = false;
             for (int j = 0; j < B.Length; ++j) {
-                A.BigInt[i + j] = A.BigInt[i + j] - B.BigInt[j] - Carry + 48;
-                if (A.BigInt[i + j] < 48) {
+                Remainder.BigInt[i + j] = Remainder.BigInt[i + j] - B.BigInt[j]
+                                          - Carry + 48;
+                if (Remainder.BigInt[i + j] < 48) {
                     Carry = true;
-                    A.BigInt[i + j] += 10;
+                    Remainder.BigInt[i + j] += 10;
                     continue;
                 }
                 Carry = false;
             }
-            if (Carry) --A.BigInt[A.Length - 1];
-            TempA[i] += 1;
-            while (A.BigInt[A.Length - 1] == '0' && A.Length > 1) {
-                --A.Length;
+            if (Carry) --Remainder.BigInt[Remainder.Length - 1];
+            Quotient.BigInt[i] += 1;
+            while (Remainder.BigInt[Remainder.Length - 1] == '0'
+                   && Remainder.Length > 1) {
+                --Remainder.Length;
             }
         }
     }
-    A.BigInt = TempA;
-    A.Length = ALength - B.Length + 1;
-    while (A.BigInt[A.Length - 1] == '0' && A.Length > 1) {
-        --A.Length;
+    while (Quotient.BigInt[Quotient.Length - 1] == '0' && Quotient.Length > 1) {
+        --Quotient.Length;
     }
-    return A;
+    Quotient.IsPositive = (A.IsPositive == B.IsPositive)
+                          || (Quotient.Length == 1 && Quotient.BigInt[0] == '0');
+    Remainder.IsPositive = A.IsPositive
+                           || (Remainder.Length == 1 && Remainder.BigInt[0] == '0');
+    return Answer;
 }
 
-
 std::istream& sjtu::operator>>(std::istream& InStream, sjtu::int2048& Target)
 {
     std::string Temp;
@@ -0,0 +1,735 @@
+// int2048
+// Lau YeeYu
+
+#ifndef SJTU_BIGINTEGER_BINARY
+#define SJTU_BIGINTEGER_BINARY
+
+
+/**
+ * BINARY IMPLEMENTATION: By using "std::vector<unsigned long long>" to store
+ * every 64 bits (binary-based), with the same interface as int2048.
+ * Decimal digits are only converted when reading and printing, so it suits
+ * long calculations whose result is printed only at the end.
+ */
+
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <utility>
+#include <vector>
+#include <algorithm>
+#include <charconv>
+
+#ifndef __SIZEOF_INT128__
+#error "int2048_binary needs the unsigned __int128 extension (GCC or Clang)"
+#endif
+
+
+
+namespace sjtu
+{
+    /// 10^19, the largest power of 10 in one element, used for conversion
+    static constexpr unsigned long long BinaryDecimalBase = 10000000000000000000ULL;
+    static constexpr int BinaryDecimalDigit = 19;
+
+    /// Multiplications whose shorter operand has at least
+    /// "BinaryKaratsubaThreshold" elements use Karatsuba
+    static constexpr int BinaryKaratsubaThreshold = 32;
+
+    class int2048_binary
+    {
+    private:
+        /// reversed big int without leading zeros (empty for 0)
+        std::vector<unsigned long long> BigInt;
+        bool IsPositive = true;
+
+        /// Remove the leading zeros (and the sign of 0)
+        int2048_binary& _resize();
+
+        /// Compare |A| and |B|, return -1, 0 or 1
+        static int _compare(const std::vector<unsigned long long>& A,
+                            const std::vector<unsigned long long>& B);
+
+        /// Abs add, return |*this| = |*this| + |B|
+        int2048_binary& _simple_add(const int2048_binary& B);
+
+        /// Abs subtraction, return |*this| = |*this| - |B|
+        /// (CAUTION: |*this| MUST be NO LESS THAN |B|)
+        int2048_binary& _simple_minus(const int2048_binary& B);
+
+        /// Reversed abs subtraction, return |*this| = |B| - |*this|
+        /// (CAUTION: |B| MUST be NO LESS THAN |*this|)
+        int2048_binary& _reversed_simple_minus(const int2048_binary& B);
+
+        /// Answer = A + B (CAUTION: ASize >= BSize), return the carry
+        static unsigned long long _add_limbs(unsigned long long* Answer,
+                                             const unsigned long long* A, int ASize,
+                                             const unsigned long long* B, int BSize);
+
+        /// Answer = A - B (CAUTION: A >= B and ASize >= BSize), return the borrow
+        static unsigned long long _sub_limbs(unsigned long long* Answer,
+                                             const unsigned long long* A, int ASize,
+                                             const unsigned long long* B, int BSize);
+
+        /// Answer[0, AnswerSize) += A, the carry is propagated to the end
+        static void _accumulate(unsigned long long* Answer, int AnswerSize,
+                                const unsigned long long* A, int ASize);
+
+        /// Unsigned multiplication, Answer[0, ASize + BSize) = A * B
+        /// (Scratch MUST hold _multiply_scratch_size(max(ASize, BSize)))
+        static void _multiply(unsigned long long* Answer,
+                              const unsigned long long* A, int ASize,
+                              const unsigned long long* B, int BSize,
+                              unsigned long long* Scratch);
+
+        /// The number of elements of scratch needed by _multiply
+        static int _multiply_scratch_size(int Size);
+
+        /// Unsigned division (Knuth's Algorithm D)
+        static void _divide(std::vector<unsigned long long>& Quotient,
+                            std::vector<unsigned long long>& Remainder,
+                            const std::vector<unsigned long long>& A,
+                            const std::vector<unsigned long long>& B);
+
+        /// A = A / Divisor, return the remainder
+        static unsigned long long _div_small(std::vector<unsigned long long>& A,
+                                             unsigned long long Divisor);
+
+        /// A = A * Multiplier + Addend
+        static void _mul_add_small(std::vector<unsigned long long>& A,
+                                   unsigned long long Multiplier,
+                                   unsigned long long Addend);
+
+        /// The decimal form of the object
+        std::string _to_string() const;
+
+    public:
+        // Constructor
+        int2048_binary();
+        int2048_binary(long long);
+        int2048_binary(const std::string&);
+        int2048_binary(const int2048_binary&);
+        int2048_binary(int2048_binary&&) noexcept;
+
+
+        /// Load a Big Int (an invalid string is loaded as 0)
+        void read(const std::string&);
+
+        /// Print the Big Int
+        void print() const;
+
+        /// Add another Big Int
+        int2048_binary& add(const int2048_binary&);
+        /// Return the Sum of Two int2048_binary
+        friend int2048_binary add(int2048_binary A, const int2048_binary& B);
+
+        /// Minus another Big Int
+        int2048_binary& minus(const int2048_binary&);
+        /// Return the Subtraction of Two int2048_binary
+        friend int2048_binary minus(int2048_binary A, const int2048_binary& B);
+
+        int2048_binary& operator=(const int2048_binary&);
+        int2048_binary& operator=(int2048_binary&&) noexcept;
+
+        int2048_binary& operator+=(const int2048_binary&);
+        friend int2048_binary operator+(int2048_binary, const int2048_binary&);
+
+        int2048_binary& operator-=(const int2048_binary&);
+        friend int2048_binary operator-(int2048_binary, const int2048_binary&);
+
+        int2048_binary& operator*=(const int2048_binary&);
+        friend int2048_binary operator*(int2048_binary, const int2048_binary&);
+
+        /// Division truncates toward zero and the remainder takes the sign
+        /// of the dividend (as built-in integers do), so that
+        /// A == A / B * B + A % B
+        int2048_binary& operator/=(const int2048_binary&);
+        friend int2048_binary operator/(int2048_binary, const int2048_binary&);
+
+        int2048_binary& operator%=(const int2048_binary&);
+        friend int2048_binary operator%(int2048_binary, const int2048_binary&);
+
+        /// Return the quotient and the remainder of one division
+        friend std::pair<int2048_binary, int2048_binary>
+        divmod(const int2048_binary&, const int2048_binary&);
+
+        /// Read a whitespace-separated word, failbit is set (and the object
+        /// is left unchanged) unless the whole word is a number
+        friend std::istream& operator>>(std::istream&, int2048_binary&);
+        friend std::ostream& operator<<(std::ostream&, const int2048_binary&);
+
+        /// Write the decimal form into [First, Last) without a terminating
+        /// '\0' (the same contract as std::to_chars)
+        friend std::to_chars_result to_chars(char* First, char* Last,
+                                             const int2048_binary&);
+
+        /// Parse an optional '-' and decimal digits from [First, Last) (the
+        /// same contract as std::from_chars), return invalid_argument and
+        /// leave the object unchanged if there is no digit
+        friend std::from_chars_result from_chars(const char* First,
+                                                 const char* Last,
+                                                 int2048_binary&);
+
+        inline friend bool operator==(const int2048_binary&, const int2048_binary&);
+        inline friend bool operator!=(const int2048_binary&, const int2048_binary&);
+        inline friend bool operator<(const int2048_binary&, const int2048_binary&);
+        inline friend bool operator>(const int2048_binary&, const int2048_binary&);
+        inline friend bool operator<=(const int2048_binary&, const int2048_binary&);
+        inline friend bool operator>=(const int2048_binary&, const int2048_binary&);
+    };
+
+    int2048_binary::int2048_binary() = default;
+
+    int2048_binary::int2048_binary(long long x)
+    {
+        if (x < 0) IsPositive = false;
+        // 0 - x in unsigned arithmetic also works for the minimum long long
+        unsigned long long Abs = (x < 0) ? 0ULL - (unsigned long long)x
+                                         : (unsigned long long)x;
+        if (Abs != 0) BigInt.push_back(Abs);
+    }
+
+    int2048_binary::int2048_binary(const std::string& String)
+    {
+        read(String);
+    }
+
+    int2048_binary::int2048_binary(const int2048_binary&) = default;
+
+    int2048_binary::int2048_binary(int2048_binary&&) noexcept = default;
+
+    void int2048_binary::read(const std::string& String)
+    {
+        const char* End = String.data() + String.size();
+        std::from_chars_result Result = from_chars(String.data(), End, *this);
+        if (Result.ec != std::errc() || Result.ptr != End) (*this) = 0;
+    }
+
+    void int2048_binary::print() const
+    {
+        std::cout << (*this);
+    }
+
+    int2048_binary& int2048_binary::_resize()
+    {
+        while (!BigInt.empty() && BigInt.back() == 0) BigInt.pop_back();
+        if (BigInt.empty()) IsPositive = true;
+        return (*this);
+    }
+
+    int int2048_binary::_compare(const std::vector<unsigned long long>& A,
+                                 const std::vector<unsigned long long>& B)
+    {
+        if (A.size() != B.size()) return (A.size() > B.size()) ? 1 : -1;
+        for (int i = (int)A.size() - 1; i >= 0; --i) {
+            if (A[i] != B[i]) return (A[i] > B[i]) ? 1 : -1;
+        }
+        return 0;
+    }
+
+    int2048_binary& int2048_binary::_simple_add(const int2048_binary& B)
+    {
+        int Size = BigInt.size();
+        int BSize = B.BigInt.size();
+        if (Size >= BSize) {
+            unsigned long long Carry = _add_limbs(BigInt.data(), BigInt.data(), Size,
+                                                  B.BigInt.data(), BSize);
+            if (Carry != 0) BigInt.push_back(Carry);
+        } else {
+            BigInt.resize(BSize, 0);
+            unsigned long long Carry = _add_limbs(BigInt.data(), B.BigInt.data(), BSize,
+                                                  BigInt.data(), Size);
+            if (Carry != 0) BigInt.push_back(Carry);
+        }
+        return (*this);
+    }
+
+    int2048_binary& int2048_binary::_simple_minus(const int2048_binary& B)
+    {
+        _sub_limbs(BigInt.data(), BigInt.data(), BigInt.size(),
+                   B.BigInt.data(), B.BigInt.size());
+        return _resize();
+    }
+
+    int2048_binary& int2048_binary::_reversed_simple_minus(const int2048_binary& B)
+    {
+        int Size = BigInt.size();
+        BigInt.resize(B.BigInt.size(), 0);
+        // Answer[i] only depends on A[i] and B[i], so it can overwrite B
+        unsigned long long Borrow = 0;
+        for (int i = 0; i < (int)B.BigInt.size(); ++i) {
+            unsigned long long Subtrahend = (i < Size) ? BigInt[i] : 0;
+            unsigned __int128 Difference = (unsigned __int128)B.BigInt[i]
+                                         - Subtrahend - Borrow;
+            BigInt[i] = (unsigned long long)Difference;
+            Borrow = (unsigned long long)(Difference >> 64) & 1;
+        }
+        return _resize();
+    }
+
+    unsigned long long int2048_binary::_add_limbs(unsigned long long* Answer,
+                                                  const unsigned long long* A, int ASize,
+                                                  const unsigned long long* B, int BSize)
+    {
+        unsigned long long Carry = 0;
+        for (int i = 0; i < BSize; ++i) {
+            unsigned __int128 Sum = (unsigned __int128)A[i] + B[i] + Carry;
+            Answer[i] = (unsigned long long)Sum;
+            Carry = (unsigned long long)(Sum >> 64);
+        }
+        for (int i = BSize; i < ASize; ++i) {
+            Answer[i] = A[i] + Carry;
+            Carry = (Answer[i] < Carry) ? 1 : 0;
+        }
+        return Carry;
+    }
+
+    unsigned long long int2048_binary::_sub_limbs(unsigned long long* Answer,
+                                                  const unsigned long long* A, int ASize,
+                                                  const unsigned long long* B, int BSize)
+    {
+        unsigned long long Borrow = 0;
+        for (int i = 0; i < BSize; ++i) {
+            unsigned __int128 Difference = (unsigned __int128)A[i] - B[i] - Borrow;
+            Answer[i] = (unsigned long long)Difference;
+            Borrow = (unsigned long long)(Difference >> 64) & 1;
+        }
+        for (int i = BSize; i < ASize; ++i) {
+            unsigned long long Element = A[i]; // Answer may be A
+            Answer[i] = Element - Borrow;
+            Borrow = (Element < Borrow) ? 1 : 0;
+        }
+        return Borrow;
+    }
+
+    void int2048_binary::_accumulate(unsigned long long* Answer, int AnswerSize,
+                                     const unsigned long long* A, int ASize)
+    {
+        unsigned long long Carry = 0;
+        int Length = std::min(AnswerSize, ASize);
+        for (int i = 0; i < Length; ++i) {
+            unsigned __int128 Sum = (unsigned __int128)Answer[i] + A[i] + Carry;
+            Answer[i] = (unsigned long long)Sum;
+            Carry = (unsigned long long)(Sum >> 64);
+        }
+        for (int i = Length; Carry != 0 && i < AnswerSize; ++i) {
+            Answer[i] += Carry;
+            Carry = (Answer[i] == 0) ? 1 : 0;
+        }
+    }
+
+    void int2048_binary::_multiply(unsigned long long* Answer,
+                                   const unsigned long long* A, int ASize,
+                                   const unsigned long long* B, int BSize,
+                                   unsigned long long* Scratch)
+    {
+        if (ASize < BSize) {
+            std::swap(A, B);
+            std::swap(ASize, BSize);
+        }
+        if (BSize < BinaryKaratsubaThreshold) {
+            std::fill(Answer, Answer + ASize + BSize, 0);
+            for (int B_Digit = 0; B_Digit < BSize; ++B_Digit) {
+                unsigned long long Carry = 0;
+                for (int A_Digit = 0; A_Digit < ASize; ++A_Digit) {
+                    unsigned __int128 Temp = (unsigned __int128)A[A_Digit] * B[B_Digit]
+                                           + Answer[A_Digit + B_Digit] + Carry;
+                    Answer[A_Digit + B_Digit] = (unsigned long long)Temp;
+                    Carry = (unsigned long long)(Temp >> 64);
+                }
+                Answer[ASize + B_Digit] = Carry;
+            }
+        } else if (BSize > (ASize + 1) / 2) {
+            // Karatsuba: A = A1 * 2^(64 * Half) + A0, so is B
+            int Half = (ASize + 1) / 2;
+            unsigned long long* SumA = Scratch;
+            unsigned long long* SumB = SumA + Half + 1;
+            unsigned long long* Middle = SumB + Half + 1;
+            unsigned long long* Next = Middle + 2 * Half + 2;
+            _multiply(Answer, A, Half, B, Half, Scratch);
+            _multiply(Answer + 2 * Half, A + Half, ASize - Half,
+                      B + Half, BSize - Half, Scratch);
+            SumA[Half] = _add_limbs(SumA, A, Half, A + Half, ASize - Half);
+            SumB[Half] = _add_limbs(SumB, B, Half, B + Half, BSize - Half);
+            _multiply(Middle, SumA, Half + 1, SumB, Half + 1, Next);
+            _sub_limbs(Middle, Middle, 2 * Half + 2, Answer, 2 * Half);
+            _sub_limbs(Middle, Middle, 2 * Half + 2,
+                       Answer + 2 * Half, ASize + BSize - 2 * Half);
+            _accumulate(Answer + Half, ASize + BSize - Half, Middle, 2 * Half + 2);
+        } else {
+            // Unbalanced: cut A into pieces as long as B
+            unsigned long long* Temp = Scratch;
+            unsigned long long* Next = Scratch + 2 * BSize;
+            _multiply(Answer, A, BSize, B, BSize, Next);
+            for (int Offset = BSize; Offset < ASize; Offset += BSize) {
+                int Length = std::min(BSize, ASize - Offset);
+                _multiply(Temp, A + Offset, Length, B, BSize, Next);
+                std::fill(Answer + Offset + BSize,
+                          Answer + Offset + BSize + Length, 0);
+                _accumulate(Answer + Offset, Length + BSize, Temp, Length + BSize);
+            }
+        }
+    }
+
+    int int2048_binary::_multiply_scratch_size(int Size)
+    {
+        int Answer = 0;
+        while (Size >= BinaryKaratsubaThreshold) {
+            Answer += 4 * Size + 16;
+            Size = Size / 2 + 2;
+        }
+        return Answer;
+    }
+
+    void int2048_binary::_divide(std::vector<unsigned long long>& Quotient,
+                                 std::vector<unsigned long long>& Remainder,
+                                 const std::vector<unsigned long long>& A,
+                                 const std::vector<unsigned long long>& B)
+    {
+        if (_compare(A, B) == -1) {
+            Quotient.clear();
+            Remainder = A;
+            return;
+        }
+        int n = B.size();
+        int m = A.size() - B.size();
+        if (n == 1) {
+            Quotient = A;
+            unsigned long long Rest = _div_small(Quotient, B[0]);
+            Remainder.assign(Rest != 0 ? 1 : 0, Rest);
+            return;
+        }
+
+        // Normalize so that the highest bit of the divisor is set
+        int Shift = __builtin_clzll(B[n - 1]);
+        std::vector<unsigned long long> U(A.size() + 1, 0);
+        std::vector<unsigned long long> V(n, 0);
+        for (int i = n - 1; i >= 0; --i) {
+            V[i] = B[i] << Shift;
+            if (Shift != 0 && i > 0) V[i] |= B[i - 1] >> (64 - Shift);
+        }
+        for (int i = (int)A.size(); i >= 0; --i) {
+            unsigned long long High = (i < (int)A.size()) ? A[i] << Shift : 0;
+            if (Shift != 0 && i > 0) High |= A[i - 1] >> (64 - Shift);
+            U[i] = High;
+        }
+
+        Quotient.assign(m + 1, 0);
+        for (int j = m; j >= 0; --j) {
+            unsigned __int128 Numerator = ((unsigned __int128)U[j + n] << 64)
+                                        | U[j + n - 1];
+            unsigned __int128 Estimate = Numerator / V[n - 1];
+            unsigned __int128 Rest = Numerator % V[n - 1];
+            while ((Estimate >> 64) != 0
+                   || Estimate * V[n - 2] > ((Rest << 64) | U[j + n - 2])) {
+                --Estimate;
+                Rest += V[n - 1];
+                if ((Rest >> 64) != 0) break;
+            }
+
+            // U[j, j + n] -= Estimate * V
+            unsigned long long Carry = 0;
+            unsigned long long Borrow = 0;
+            for (int i = 0; i < n; ++i) {
+                unsigned __int128 Product = Estimate * V[i] + Carry;
+                Carry = (unsigned long long)(Product >> 64);
+                unsigned __int128 Difference = (unsigned __int128)U[i + j]
+                                             - (unsigned long long)Product - Borrow;
+                U[i + j] = (unsigned long long)Difference;
+                Borrow = (unsigned long long)(Difference >> 64) & 1;
+            }
+            unsigned __int128 Top = (unsigned __int128)U[j + n] - Carry - Borrow;
+            U[j + n] = (unsigned long long)Top;
+            if ((Top >> 64) != 0) { // Still one too large, add V back
+                --Estimate;
+                U[j + n] += _add_limbs(U.data() + j, U.data() + j, n, V.data(), n);
+            }
+            Quotient[j] = (unsigned long long)Estimate;
+        }
+        while (!Quotient.empty() && Quotient.back() == 0) Quotient.pop_back();
+
+        Remainder.assign(n, 0);
+        for (int i = 0; i < n; ++i) {
+            Remainder[i] = U[i] >> Shift;
+            if (Shift != 0) Remainder[i] |= U[i + 1] << (64 - Shift);
+        }
+        while (!Remainder.empty() && Remainder.back() == 0) Remainder.pop_back();
+    }
+
+    unsigned long long int2048_binary::_div_small(std::vector<unsigned long long>& A,
+                                                  unsigned long long Divisor)
+    {
+        unsigned long long Remainder = 0;
+        for (int i = (int)A.size() - 1; i >= 0; --i) {
+            unsigned __int128 Temp = ((unsigned __int128)Remainder << 64) | A[i];
+            A[i] = (unsigned long long)(Temp / Divisor);
+            Remainder = (unsigned long long)(Temp % Divisor);
+        }
+        while (!A.empty() && A.back() == 0) A.pop_back();
+        return Remainder;
+    }
+
+    void int2048_binary::_mul_add_small(std::vector<unsigned long long>& A,
+                                        unsigned long long Multiplier,
+                                        unsigned long long Addend)
+    {
+        unsigned long long Carry = Addend;
+        for (unsigned long long& Element : A) {
+            unsigned __int128 Temp = (unsigned __int128)Element * Multiplier + Carry;
+            Element = (unsigned long long)Temp;
+            Carry = (unsigned long long)(Temp >> 64);
+        }
+        if (Carry != 0) A.push_back(Carry);
+    }
+
+    std::string int2048_binary::_to_string() const
+    {
+        // Peel off 19 decimal digits at a time from the lowest end
+        std::vector<unsigned long long> Rest = BigInt;
+        std::vector<unsigned long long> Chunks;
+        while (!Rest.empty()) Chunks.push_back(_div_small(Rest, BinaryDecimalBase));
+        if (Chunks.empty()) return "0";
+
+        std::string Answer = IsPositive ? "" : "-";
+        Answer += std::to_string(Chunks.back());
+        for (int i = (int)Chunks.size() - 2; i >= 0; --i) {
+            std::string Digits = std::to_string(Chunks[i]);
+            Answer.append(BinaryDecimalDigit - Digits.size(), '0');
+            Answer += Digits;
+        }
+        return Answer;
+    }
+
+    int2048_binary& int2048_binary::add(const int2048_binary& B)
+    {
+        return (*this += B);
+    }
+
+    int2048_binary add(int2048_binary A, const int2048_binary& B)
+    {
+        return (A += B);
+    }
+
+    int2048_binary& int2048_binary::minus(const int2048_binary& B)
+    {
+        return (*this -= B);
+    }
+
+    int2048_binary minus(int2048_binary A, const int2048_binary& B)
+    {
+        return (A -= B);
+    }
+
+    int2048_binary& int2048_binary::operator=(const int2048_binary&) = default;
+
+    int2048_binary& int2048_binary::operator=(int2048_binary&&) noexcept = default;
+
+    int2048_binary& int2048_binary::operator+=(const int2048_binary& B)
+    {
+        if (IsPositive == B.IsPositive) {
+            this->_simple_add(B);
+        } else {
+            int Compare = _compare(BigInt, B.BigInt);
+            if (Compare == 1) {
+                this->_simple_minus(B);
+            } else if (Compare == 0) {
+                BigInt.clear();
+                IsPositive = true;
+            } else {
+                this->_reversed_simple_minus(B);
+                IsPositive = !IsPositive;
+            }
+        }
+        return (*this);
+    }
+
+    int2048_binary operator+(int2048_binary A, const int2048_binary& B)
+    {
+        return (A += B);
+    }
+
+    int2048_binary& int2048_binary::operator-=(const int2048_binary& B)
+    {
+        if (IsPositive != B.IsPositive) {
+            this->_simple_add(B);
+        } else {
+            int Compare = _compare(BigInt, B.BigInt);
+            if (Compare == 1) {
+                this->_simple_minus(B);
+            } else if (Compare == 0) {
+                BigInt.clear();
+                IsPositive = true;
+            } else {
+                this->_reversed_simple_minus(B);
+                IsPositive = !IsPositive;
+            }
+        }
+        return (*this);
+    }
+
+    int2048_binary operator-(int2048_binary A, const int2048_binary& B)
+    {
+        return (A -= B);
+    }
+
+    int2048_binary& int2048_binary::operator*=(const int2048_binary& B)
+    {
+        if (BigInt.empty() || B.BigInt.empty()) {
+            BigInt.clear();
+            IsPositive = true;
+            return (*this);
+        }
+        IsPositive = (IsPositive == B.IsPositive);
+
+        // The scratch is kept between calls to avoid allocating memory
+        static thread_local std::vector<unsigned long long> Scratch;
+        int ASize = BigInt.size();
+        int BSize = B.BigInt.size();
+        int ScratchSize = _multiply_scratch_size(std::max(ASize, BSize));
+        if ((int)Scratch.size() < ScratchSize) Scratch.resize(ScratchSize);
+        std::vector<unsigned long long> Answer(ASize + BSize);
+        _multiply(Answer.data(), BigInt.data(), ASize, B.BigInt.data(), BSize,
+                  Scratch.data());
+        BigInt.swap(Answer);
+        return _resize();
+    }
+
+    int2048_binary operator*(int2048_binary A, const int2048_binary& B)
+    {
+        return (A *= B);
+    }
+
+    int2048_binary& int2048_binary::operator/=(const int2048_binary& B)
+    {
+        return (*this = divmod(*this, B).first);
+    }
+
+    int2048_binary operator/(int2048_binary A, const int2048_binary& B)
+    {
+        return (A /= B);
+    }
+
+    int2048_binary& int2048_binary::operator%=(const int2048_binary& B)
+    {
+        return (*this = divmod(*this, B).second);
+    }
+
+    int2048_binary operator%(int2048_binary A, const int2048_binary& B)
+    {
+        return (A %= B);
+    }
+
+    std::pair<int2048_binary, int2048_binary> divmod(const int2048_binary& A,
+                                                     const int2048_binary& B)
+    {
+        std::pair<int2048_binary, int2048_binary> Answer;
+        int2048_binary::_divide(Answer.first.BigInt, Answer.second.BigInt,
+                                A.BigInt, B.BigInt);
+        Answer.first.IsPositive = (A.IsPositive == B.IsPositive);
+        Answer.second.IsPositive = A.IsPositive;
+        Answer.first._resize();
+        Answer.second._resize();
+        return Answer;
+    }
+
+    std::istream& operator>>(std::istream& InStream, int2048_binary& Object)
+    {
+        // The buffer is kept between calls to avoid allocating memory
+        static thread_local std::string Buffer;
+        if (!(InStream >> Buffer)) return InStream;
+        const char* End = Buffer.data() + Buffer.size();
+        int2048_binary Temp;
+        std::from_chars_result Result = from_chars(Buffer.data(), End, Temp);
+        if (Result.ec != std::errc() || Result.ptr != End) {
+            InStream.setstate(std::ios::failbit);
+        } else {
+            Object = std::move(Temp);
+        }
+        return InStream;
+    }
+
+    std::ostream& operator<<(std::ostream& OutStream, const int2048_binary& Object)
+    {
+        std::string String = Object._to_string();
+        OutStream.write(String.data(), String.size());
+        return OutStream;
+    }
+
+    std::to_chars_result to_chars(char* First, char* Last,
+                                  const int2048_binary& Object)
+    {
+        std::string String = Object._to_string();
+        if (Last - First < (long long)String.size()) {
+            return {Last, std::errc::value_too_large};
+        }
+        std::memcpy(First, String.data(), String.size());
+        return {First + String.size(), std::errc()};
+    }
+
+    std::from_chars_result from_chars(const char* First, const char* Last,
+                                      int2048_binary& Object)
+    {
+        const char* Begin = First;
+        bool IsPositive = true;
+        if (First != Last && *First == '-') {
+            IsPositive = false;
+            ++First;
+        }
+        const char* Digits = First;
+        while (First != Last && '0' <= *First && *First <= '9') ++First;
+        if (First == Digits) return {Begin, std::errc::invalid_argument};
+
+        // Horner's rule with 19 digits at a time, the first chunk is shorter
+        std::vector<unsigned long long> Answer;
+        long long Length = First - Digits;
+        int ChunkLength = (Length - 1) % BinaryDecimalDigit + 1;
+        for (const char* Current = Digits; Current != First; ) {
+            unsigned long long Chunk = 0;
+            unsigned long long Scale = 1;
+            for (int i = 0; i < ChunkLength; ++i, ++Current) {
+                Chunk = Chunk * 10 + (*Current - '0');
+                Scale *= 10;
+            }
+            int2048_binary::_mul_add_small(Answer, Scale, Chunk);
+            ChunkLength = BinaryDecimalDigit;
+        }
+        Object.BigInt.swap(Answer);
+        Object.IsPositive = IsPositive;
+        Object._resize();
+        return {First, std::errc()};
+    }
+
+    bool operator==(const int2048_binary& A, const int2048_binary& B)
+    {
+        return A.IsPositive == B.IsPositive && A.BigInt == B.BigInt;
+    }
+
+    bool operator!=(const int2048_binary& A, const int2048_binary& B)
+    {
+        return (!(A == B));
+    }
+
+    bool operator<(const int2048_binary& A, const int2048_binary& B)
+    {
+        if (A.IsPositive != B.IsPositive) return B.IsPositive;
+        int Compare = int2048_binary::_compare(A.BigInt, B.BigInt);
+        return A.IsPositive ? (Compare == -1) : (Compare == 1);
+    }
+
+    bool operator>(const int2048_binary& A, const int2048_binary& B)
+    {
+        return (B < A);
+    }
+
+    bool operator<=(const int2048_binary& A, const int2048_binary& B)
+    {
+        return (!(B < A));
+    }
+
+    bool operator>=(const int2048_binary& A, const int2048_binary& B)
+    {
+        return (!(A < B));
+    }
+}
+
+#endif
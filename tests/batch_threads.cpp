@@ -0,0 +1,97 @@
+// int2048
+// Lau YeeYu
+
+/**
+ * Regression test of batch_eval on several threads: two threads evaluate
+ * batches at the same time on a pool of three, each with a division long
+ * enough for Newton's method and parallel transforms, beside many medium
+ * ones. A thread waiting for the transforms of one job used to start
+ * another job, which overwrote the quotient of the first one. Every answer
+ * is compared to the same operation on a single thread.
+ */
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "int2048.hpp"
+
+static std::mt19937_64 Generator(2048);
+
+/// A random number of Size elements (9 digits each), with any sign
+static sjtu::int2048 RandomNumber(int Size)
+{
+    std::string Digits(1, (char)('1' + Generator() % 9));
+    for (int i = 1; i < 9 * Size; ++i) Digits += (char)('0' + Generator() % 10);
+    if (Generator() % 2 == 0) Digits = "-" + Digits;
+    return sjtu::int2048(Digits);
+}
+
+struct batch
+{
+    std::vector<sjtu::int2048> Operands;
+    std::vector<sjtu::batch_job> Jobs;
+    std::vector<sjtu::int2048> Expected;
+    std::vector<sjtu::int2048> Answers;
+};
+
+/// The remainder of a number of 120000 elements by one of 4000, then 1499
+/// divisions of up to 1200 elements by up to 600
+static batch MakeBatch()
+{
+    batch Batch;
+    Batch.Operands.reserve(3000);
+    Batch.Operands.push_back(RandomNumber(120000));
+    Batch.Operands.push_back(RandomNumber(4000));
+    for (int i = 0; i < 1499; ++i) {
+        int BSize = 1 + (int)(Generator() % 600);
+        Batch.Operands.push_back(RandomNumber(BSize + (int)(Generator() % 600)));
+        Batch.Operands.push_back(RandomNumber(BSize));
+    }
+    for (size_t i = 0; i < Batch.Operands.size(); i += 2) {
+        Batch.Jobs.push_back({i == 0 ? sjtu::batch_job::Remainder
+                                     : sjtu::batch_job::Divide,
+                              &Batch.Operands[i], &Batch.Operands[i + 1]});
+    }
+    for (const sjtu::batch_job& Job : Batch.Jobs) {
+        Batch.Expected.push_back(Job.Operation == sjtu::batch_job::Remainder
+                                     ? *Job.A % *Job.B : *Job.A / *Job.B);
+    }
+    Batch.Answers.resize(Batch.Jobs.size());
+    return Batch;
+}
+
+int main()
+{
+    // The expected answers on a single thread
+    sjtu::parallel::set_threads(1);
+    std::vector<batch> Batches;
+    for (int i = 0; i < 2; ++i) Batches.push_back(MakeBatch());
+
+    sjtu::parallel::set_threads(3);
+    std::vector<std::thread> Threads;
+    for (batch& Batch : Batches) {
+        Threads.emplace_back([&Batch] {
+            sjtu::batch_eval(Batch.Jobs.data(), (int)Batch.Jobs.size(),
+                             Batch.Answers.data());
+        });
+    }
+    for (std::thread& Thread : Threads) Thread.join();
+
+    int Failures = 0;
+    int Cases = 0;
+    for (const batch& Batch : Batches) {
+        for (size_t i = 0; i < Batch.Jobs.size(); ++i) {
+            ++Cases;
+            if (Batch.Answers[i] == Batch.Expected[i]) continue;
+            if (++Failures <= 10) {
+                std::printf("FAIL: job %zu (%s)\n", i,
+                            i == 0 ? "the long remainder" : "a division");
+            }
+        }
+    }
+    std::printf("%d jobs, %d failed\n", Cases, Failures);
+    return Failures == 0 ? 0 : 1;
+}
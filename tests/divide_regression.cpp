@@ -0,0 +1,229 @@
+// int2048
+// Lau YeeYu
+
+/**
+ * Regression test of the long division (Knuth's Algorithm D in
+ * int2048::_basecase_divide) against the binary-search division it
+ * replaced, on random operands and on operands built to reach the
+ * normalization and correction steps. The divisors and quotients stay
+ * shorter than NewtonThreshold elements, so every division below runs
+ * through _basecase_divide.
+ */
+
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// For the count of the divisions which add the divisor back
+#define SJTU_INT2048_STATS
+#include "int2048.hpp"
+
+using Limbs = std::vector<long long>;
+
+static constexpr long long Base = 1000000000;
+
+/// The decimal digits of elements lowest first
+static std::string ToDigits(const Limbs& A)
+{
+    std::string Answer = std::to_string(A.back());
+    char Buffer[16];
+    for (int i = (int)A.size() - 2; i >= 0; --i) {
+        std::snprintf(Buffer, sizeof(Buffer), "%09lld", A[i]);
+        Answer += Buffer;
+    }
+    return Answer;
+}
+
+static std::string ToDigits(const sjtu::int2048& A)
+{
+    std::ostringstream Stream;
+    Stream << A;
+    return Stream.str();
+}
+
+/// B * Factor (Factor < Base), as the old _single_multiply
+static Limbs SingleMultiply(const Limbs& B, long long Factor)
+{
+    Limbs Answer(B.size() + 1, 0);
+    long long Carry = 0;
+    for (size_t i = 0; i < B.size(); ++i) {
+        long long Product = B[i] * Factor + Carry;
+        Answer[i] = Product % Base;
+        Carry = Product / Base;
+    }
+    Answer[B.size()] = Carry;
+    return Answer;
+}
+
+/// Whether A[Offset, Size) < B, both without leading zero elements
+static bool LessAt(const Limbs& A, int Offset, int Size, const Limbs& B)
+{
+    int BSize = (int)B.size();
+    while (BSize > 1 && B[BSize - 1] == 0) --BSize;
+    if (Size - Offset != BSize) return Size - Offset < BSize;
+    for (int i = BSize - 1; i >= 0; --i) {
+        if (A[Offset + i] != B[i]) return A[Offset + i] < B[i];
+    }
+    return false;
+}
+
+/// The division int2048 used before Algorithm D: every element of the
+/// quotient is the largest q with B * q <= the remainder, found by binary
+/// search
+static void BinarySearchDivide(const Limbs& A, const Limbs& B, Limbs& Quotient,
+                               Limbs& Remainder)
+{
+    Remainder = A;
+    int Size = (int)A.size();
+    int BSize = (int)B.size();
+    if (Size < BSize) {
+        Quotient.assign(1, 0);
+        return;
+    }
+    Quotient.assign(Size - BSize + 1, 0);
+    for (int i = Size - BSize; i >= 0; --i) {
+        long long L = 0;
+        long long R = Base;
+        while (R - L > 1) {
+            long long Middle = (L + R) / 2;
+            if (LessAt(Remainder, i, Size, SingleMultiply(B, Middle))) {
+                R = Middle;
+            } else {
+                L = Middle;
+            }
+        }
+        Limbs Product = SingleMultiply(B, L);
+        long long Borrow = 0;
+        for (size_t j = 0; j < Product.size() && i + (int)j < Size; ++j) {
+            Remainder[i + j] -= Product[j] + Borrow;
+            Borrow = 0;
+            if (Remainder[i + j] < 0) {
+                Remainder[i + j] += Base;
+                Borrow = 1;
+            }
+        }
+        Quotient[i] = L;
+        while (Size > 1 && Remainder[Size - 1] == 0) --Size;
+    }
+    Remainder.resize(Size);
+    while (Quotient.size() > 1 && Quotient.back() == 0) Quotient.pop_back();
+}
+
+static int Failures = 0;
+static int Cases = 0;
+
+/// Compare A / B and A % B of both divisions, with every sign of A and B
+static void Check(const Limbs& A, const Limbs& B)
+{
+    Limbs ExactQuotient;
+    Limbs ExactRemainder;
+    BinarySearchDivide(A, B, ExactQuotient, ExactRemainder);
+    std::string ExpectQuotient = ToDigits(ExactQuotient);
+    std::string ExpectRemainder = ToDigits(ExactRemainder);
+    for (int Signs = 0; Signs < 4; ++Signs) {
+        std::string SignA = Signs & 1 ? "-" : "";
+        std::string SignB = Signs & 2 ? "-" : "";
+        sjtu::int2048 X(SignA + ToDigits(A));
+        sjtu::int2048 Y(SignB + ToDigits(B));
+
+        // Truncation toward zero, the remainder takes the sign of A
+        std::string Quotient = ExpectQuotient;
+        std::string Remainder = ExpectRemainder;
+        if (SignA != SignB && Quotient != "0") Quotient = "-" + Quotient;
+        if (!SignA.empty() && Remainder != "0") Remainder = "-" + Remainder;
+        std::string GotQuotient = ToDigits(X / Y);
+        std::string GotRemainder = ToDigits(X % Y);
+        ++Cases;
+        if (GotQuotient == Quotient && GotRemainder == Remainder) continue;
+        if (++Failures <= 10) {
+            std::printf("FAIL: %s / %s\n  expected %s, %s\n  got %s, %s\n",
+                        ToDigits(X).c_str(), ToDigits(Y).c_str(),
+                        Quotient.c_str(), Remainder.c_str(),
+                        GotQuotient.c_str(), GotRemainder.c_str());
+        }
+    }
+}
+
+static std::mt19937_64 Generator(2048);
+
+static long long RandomLimb(long long Low = 0, long long High = Base - 1)
+{
+    return std::uniform_int_distribution<long long>(Low, High)(Generator);
+}
+
+/// Size random elements under a given highest element
+static Limbs RandomLimbs(int Size, long long Top)
+{
+    Limbs Answer(Size);
+    for (long long& Limb : Answer) Limb = RandomLimb();
+    Answer[Size - 1] = Top;
+    return Answer;
+}
+
+/// A dividend whose highest n + 1 elements are Estimate times the highest
+/// two elements of B (n = B.size()), shifted up by Extra random elements,
+/// so that the estimate of the highest quotient element is exactly
+/// Estimate but B * Estimate exceeds the dividend by the lower elements of
+/// B: the quotient element is Estimate - 1, found by adding B back
+static Limbs AddBackDividend(const Limbs& B, long long Estimate, int Extra)
+{
+    int n = (int)B.size();
+    Limbs Top(B.end() - 2, B.end());
+    Limbs Product = SingleMultiply(Top, Estimate);
+    Limbs Answer = RandomLimbs(Extra + n - 2, RandomLimb());
+    Answer.insert(Answer.end(), Product.begin(), Product.end());
+    while (Answer.size() > 1 && Answer.back() == 0) Answer.pop_back();
+    return Answer;
+}
+
+int main()
+{
+    // Random operands of every length up to 60 elements
+    for (int Round = 0; Round < 3000; ++Round) {
+        int BSize = (int)RandomLimb(1, 60);
+        int ASize = BSize + (int)RandomLimb(-2, 60);
+        if (ASize < 1) ASize = 1;
+        Check(RandomLimbs(ASize, RandomLimb(1)), RandomLimbs(BSize, RandomLimb(1)));
+    }
+
+    // Normalization: the highest element of the divisor 1 (the largest
+    // factor) or Max - 1 (no factor), against dividends whose highest
+    // element is equal to it, so that the first estimate reaches Max
+    for (int Round = 0; Round < 1000; ++Round) {
+        int BSize = (int)RandomLimb(2, 30);
+        int ASize = BSize + (int)RandomLimb(0, 30);
+        long long BTop = Round % 2 == 0 ? 1 : Base - 1;
+        Limbs B = RandomLimbs(BSize, BTop);
+        Check(RandomLimbs(ASize, RandomLimb(1)), B);
+        Limbs A = RandomLimbs(ASize, BTop);
+        for (int i = 1; i <= BSize && i < ASize; ++i) {
+            if (Round % 3 == 0) A[ASize - 1 - i] = B[BSize - 1 - i];
+        }
+        Check(A, B);
+        Check(B, B);
+    }
+
+    // Both corrections: the highest two elements of the divisor near Max / 2
+    // and Max, so that the estimate is lowered by the third element of the
+    // remainder, and then still one too large and B is added back
+    sjtu::stats::reset();
+    for (int Round = 0; Round < 1000; ++Round) {
+        int BSize = (int)RandomLimb(3, 30);
+        Limbs B = RandomLimbs(BSize, RandomLimb(Base / 2, Base / 2 + 1000));
+        B[BSize - 2] = RandomLimb(Base - 1000);
+        B[0] = RandomLimb(Base / 2);
+        Check(AddBackDividend(B, RandomLimb(Base - 1000, Base - 1),
+                              (int)RandomLimb(0, 30)), B);
+    }
+    unsigned long long AddBacks = sjtu::stats::snapshot().DivisionCorrections;
+
+    std::printf("%d divisions, %d failed, %llu added back\n", Cases, Failures,
+                AddBacks);
+    if (AddBacks == 0) {
+        std::printf("FAIL: no division added the divisor back\n");
+        return 1;
+    }
+    return Failures == 0 ? 0 : 1;
+}